@@ -0,0 +1,257 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_ARENA_ALLOCATOR_HPP
+#define JSONCONS_ARENA_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <limits>
+#include <type_traits>
+#include <algorithm>
+#include <jsoncons/jsoncons_config.hpp>
+
+namespace jsoncons {
+
+// arena
+
+// Hands out memory from a chain of large blocks. Memory is never returned to
+// the arena one allocation at a time, it is all made available again by
+// reset(), which keeps the blocks for reuse, or returned to the system by
+// release() and the destructor. An arena is not safe to use from several
+// threads at once.
+
+class arena
+{
+    struct block
+    {
+        block* next;
+        size_t size;
+    };
+
+    static const size_t header_size = (sizeof(block) + JSONCONS_ALIGNOF(std::max_align_t) - 1) & ~(JSONCONS_ALIGNOF(std::max_align_t) - 1);
+
+    size_t block_size_;
+    block* head_;
+    block* current_;
+    size_t offset_;
+
+    // Noncopyable and nonmoveable
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+public:
+    static const size_t default_block_size = 64*1024;
+
+    arena()
+        : block_size_(default_block_size), head_(nullptr), current_(nullptr), offset_(0)
+    {
+    }
+
+    explicit arena(size_t block_size)
+        : block_size_((std::max)(block_size, static_cast<size_t>(256))), head_(nullptr), current_(nullptr), offset_(0)
+    {
+    }
+
+    ~arena()
+    {
+        release();
+    }
+
+    size_t block_size() const
+    {
+        return block_size_;
+    }
+
+    void* allocate(size_t n, size_t alignment)
+    {
+        if (current_ != nullptr)
+        {
+            size_t offset = (offset_ + alignment - 1) & ~(alignment - 1);
+            if (offset <= current_->size && n <= current_->size - offset)
+            {
+                offset_ = offset + n;
+                return data(current_) + offset;
+            }
+        }
+        return allocate_from_next_block(n, alignment);
+    }
+
+    // Makes all memory available again without returning blocks to the
+    // system. Everything allocated from the arena must be destroyed first.
+
+    void reset()
+    {
+        current_ = head_;
+        offset_ = 0;
+    }
+
+    void release()
+    {
+        while (head_ != nullptr)
+        {
+            block* next = head_->next;
+            ::operator delete(head_);
+            head_ = next;
+        }
+        current_ = nullptr;
+        offset_ = 0;
+    }
+
+    // The total size of the blocks held by the arena
+
+    size_t capacity() const
+    {
+        size_t size = 0;
+        for (block* b = head_; b != nullptr; b = b->next)
+        {
+            size += b->size;
+        }
+        return size;
+    }
+
+private:
+    static char* data(block* b)
+    {
+        return reinterpret_cast<char*>(b) + header_size;
+    }
+
+    void* allocate_from_next_block(size_t n, size_t alignment)
+    {
+        // Blocks are aligned for any fundamental type
+        if (n > (std::numeric_limits<size_t>::max)() - header_size - alignment)
+        {
+            throw std::bad_alloc();
+        }
+        size_t needed = n + (alignment > JSONCONS_ALIGNOF(std::max_align_t) ? alignment : 0);
+
+        // Reuse the following block after a reset if it is large enough,
+        // otherwise insert a new one in front of it
+        block* next = current_ != nullptr ? current_->next : head_;
+        if (next == nullptr || next->size < needed)
+        {
+            size_t size = (std::max)(block_size_, needed);
+            block* b = static_cast<block*>(::operator new(header_size + size));
+            b->size = size;
+            b->next = next;
+            if (current_ != nullptr)
+            {
+                current_->next = b;
+            }
+            else
+            {
+                head_ = b;
+            }
+            next = b;
+        }
+        current_ = next;
+        offset_ = 0;
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(data(current_));
+        size_t offset = static_cast<size_t>(((address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1)) - address);
+        offset_ = offset + n;
+        return data(current_) + offset;
+    }
+};
+
+// arena_allocator
+
+// A stateful allocator that takes memory from an arena, for use as the
+// Allocator of basic_json. deallocate does nothing, the memory is reclaimed
+// when the arena is reset. A default constructed arena_allocator has no
+// arena and uses the global operator new and delete, so that values built
+// without an allocator can still be placed in arena allocated containers.
+// Each allocation is released by a copy of the allocator that made it.
+
+template <class T>
+class arena_allocator
+{
+    template <class U> friend class arena_allocator;
+
+    arena* arena_;
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template <class U>
+    struct rebind
+    {
+        typedef arena_allocator<U> other;
+    };
+
+    arena_allocator() JSONCONS_NOEXCEPT
+        : arena_(nullptr)
+    {
+    }
+
+    arena_allocator(arena& a) JSONCONS_NOEXCEPT
+        : arena_(std::addressof(a))
+    {
+    }
+
+    template <class U>
+    arena_allocator(const arena_allocator<U>& other) JSONCONS_NOEXCEPT
+        : arena_(other.arena_)
+    {
+    }
+
+    arena* get_arena() const JSONCONS_NOEXCEPT
+    {
+        return arena_;
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n > max_size())
+        {
+            throw std::bad_alloc();
+        }
+        if (arena_ == nullptr)
+        {
+            return static_cast<T*>(::operator new(n*sizeof(T)));
+        }
+        return static_cast<T*>(arena_->allocate(n*sizeof(T), JSONCONS_ALIGNOF(T)));
+    }
+
+    void deallocate(T* p, size_t) JSONCONS_NOEXCEPT
+    {
+        if (arena_ == nullptr)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    size_t max_size() const JSONCONS_NOEXCEPT
+    {
+        return (std::numeric_limits<size_t>::max)() / sizeof(T);
+    }
+
+    template <class U>
+    bool operator==(const arena_allocator<U>& other) const JSONCONS_NOEXCEPT
+    {
+        return arena_ == other.arena_;
+    }
+
+    template <class U>
+    bool operator!=(const arena_allocator<U>& other) const JSONCONS_NOEXCEPT
+    {
+        return arena_ != other.arena_;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,282 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DOUBLE_TO_DECIMAL_HPP
+#define JSONCONS_DOUBLE_TO_DECIMAL_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/decimal_to_double.hpp>
+
+namespace jsoncons {
+
+// Conversion of a double to the decimal digits of a short number that reads
+// back as the same double, with Florian Loitsch's Grisu2 algorithm. The
+// result always reads back exactly, and is the shortest such number for all
+// but a small fraction of doubles, for which it has one digit more.
+
+struct double_to_decimal_diy_fp
+{
+    uint64_t f;
+    int e;
+
+    double_to_decimal_diy_fp(uint64_t f_, int e_)
+        : f(f_), e(e_)
+    {
+    }
+
+    double_to_decimal_diy_fp operator-(const double_to_decimal_diy_fp& y) const
+    {
+        return double_to_decimal_diy_fp(f - y.f, e);
+    }
+
+    // The upper 64 bits of the product, rounded
+
+    double_to_decimal_diy_fp operator*(const double_to_decimal_diy_fp& y) const
+    {
+        decimal_to_double_uint128 product = full_multiplication(f, y.f);
+        uint64_t h = product.high + (product.low >> 63);
+        return double_to_decimal_diy_fp(h, e + y.e + 64);
+    }
+
+    double_to_decimal_diy_fp normalize() const
+    {
+        int lz = leading_zeros64(f);
+        return double_to_decimal_diy_fp(f << lz, e - lz);
+    }
+};
+
+struct double_to_decimal_cached_power
+{
+    uint64_t f;
+    int e;
+    int k;
+};
+
+// Normalized 64 bit approximations of 10^k, rounded to nearest, for k in
+// [-300,324] in steps of 8
+
+inline
+const double_to_decimal_cached_power& cached_power_for_binary_exponent(int e)
+{
+    static const double_to_decimal_cached_power table[] = {
+        { 0xAB70FE17C79AC6CA, -1060, -300 },
+        { 0xFF77B1FCBEBCDC4F, -1034, -292 },
+        { 0xBE5691EF416BD60C, -1007, -284 },
+        { 0x8DD01FAD907FFC3C,  -980, -276 },
+        { 0xD3515C2831559A83,  -954, -268 },
+        { 0x9D71AC8FADA6C9B5,  -927, -260 },
+        { 0xEA9C227723EE8BCB,  -901, -252 },
+        { 0xAECC49914078536D,  -874, -244 },
+        { 0x823C12795DB6CE57,  -847, -236 },
+        { 0xC21094364DFB5637,  -821, -228 },
+        { 0x9096EA6F3848984F,  -794, -220 },
+        { 0xD77485CB25823AC7,  -768, -212 },
+        { 0xA086CFCD97BF97F4,  -741, -204 },
+        { 0xEF340A98172AACE5,  -715, -196 },
+        { 0xB23867FB2A35B28E,  -688, -188 },
+        { 0x84C8D4DFD2C63F3B,  -661, -180 },
+        { 0xC5DD44271AD3CDBA,  -635, -172 },
+        { 0x936B9FCEBB25C996,  -608, -164 },
+        { 0xDBAC6C247D62A584,  -582, -156 },
+        { 0xA3AB66580D5FDAF6,  -555, -148 },
+        { 0xF3E2F893DEC3F126,  -529, -140 },
+        { 0xB5B5ADA8AAFF80B8,  -502, -132 },
+        { 0x87625F056C7C4A8B,  -475, -124 },
+        { 0xC9BCFF6034C13053,  -449, -116 },
+        { 0x964E858C91BA2655,  -422, -108 },
+        { 0xDFF9772470297EBD,  -396, -100 },
+        { 0xA6DFBD9FB8E5B88F,  -369,  -92 },
+        { 0xF8A95FCF88747D94,  -343,  -84 },
+        { 0xB94470938FA89BCF,  -316,  -76 },
+        { 0x8A08F0F8BF0F156B,  -289,  -68 },
+        { 0xCDB02555653131B6,  -263,  -60 },
+        { 0x993FE2C6D07B7FAC,  -236,  -52 },
+        { 0xE45C10C42A2B3B06,  -210,  -44 },
+        { 0xAA242499697392D3,  -183,  -36 },
+        { 0xFD87B5F28300CA0E,  -157,  -28 },
+        { 0xBCE5086492111AEB,  -130,  -20 },
+        { 0x8CBCCC096F5088CC,  -103,  -12 },
+        { 0xD1B71758E219652C,   -77,   -4 },
+        { 0x9C40000000000000,   -50,    4 },
+        { 0xE8D4A51000000000,   -24,   12 },
+        { 0xAD78EBC5AC620000,     3,   20 },
+        { 0x813F3978F8940984,    30,   28 },
+        { 0xC097CE7BC90715B3,    56,   36 },
+        { 0x8F7E32CE7BEA5C70,    83,   44 },
+        { 0xD5D238A4ABE98068,   109,   52 },
+        { 0x9F4F2726179A2245,   136,   60 },
+        { 0xED63A231D4C4FB27,   162,   68 },
+        { 0xB0DE65388CC8ADA8,   189,   76 },
+        { 0x83C7088E1AAB65DB,   216,   84 },
+        { 0xC45D1DF942711D9A,   242,   92 },
+        { 0x924D692CA61BE758,   269,  100 },
+        { 0xDA01EE641A708DEA,   295,  108 },
+        { 0xA26DA3999AEF774A,   322,  116 },
+        { 0xF209787BB47D6B85,   348,  124 },
+        { 0xB454E4A179DD1877,   375,  132 },
+        { 0x865B86925B9BC5C2,   402,  140 },
+        { 0xC83553C5C8965D3D,   428,  148 },
+        { 0x952AB45CFA97A0B3,   455,  156 },
+        { 0xDE469FBD99A05FE3,   481,  164 },
+        { 0xA59BC234DB398C25,   508,  172 },
+        { 0xF6C69A72A3989F5C,   534,  180 },
+        { 0xB7DCBF5354E9BECE,   561,  188 },
+        { 0x88FCF317F22241E2,   588,  196 },
+        { 0xCC20CE9BD35C78A5,   614,  204 },
+        { 0x98165AF37B2153DF,   641,  212 },
+        { 0xE2A0B5DC971F303A,   667,  220 },
+        { 0xA8D9D1535CE3B396,   694,  228 },
+        { 0xFB9B7CD9A4A7443C,   720,  236 },
+        { 0xBB764C4CA7A44410,   747,  244 },
+        { 0x8BAB8EEFB6409C1A,   774,  252 },
+        { 0xD01FEF10A657842C,   800,  260 },
+        { 0x9B10A4E5E9913129,   827,  268 },
+        { 0xE7109BFBA19C0C9D,   853,  276 },
+        { 0xAC2820D9623BF429,   880,  284 },
+        { 0x80444B5E7AA7CF85,   907,  292 },
+        { 0xBF21E44003ACDD2D,   933,  300 },
+        { 0x8E679C2F5E44FF8F,   960,  308 },
+        { 0xD433179D9C8CB841,   986,  316 },
+        { 0x9E19DB92B4E31BA9,  1013,  324 },
+    };
+
+    // Choose k so that the exponent of w times 10^-k lies in [-60,-32]
+    const int alpha = -60;
+    const int f = alpha - e - 1;
+    const int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+    const int index = (300 + k + 7) / 8;
+    return table[index];
+}
+
+inline
+uint32_t largest_power_of_ten(uint32_t n, int& digits)
+{
+    static const uint32_t powers[] = {
+        1,10,100,1000,10000,100000,1000000,10000000,100000000,1000000000
+    };
+    digits = 10;
+    while (digits > 1 && n < powers[digits-1])
+    {
+        --digits;
+    }
+    return powers[digits-1];
+}
+
+// Moves the last digit down while that brings the digits closer to w and
+// keeps them inside the rounding interval
+
+inline
+void grisu2_round(char* digits, int length, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t ten_k)
+{
+    while (rest < dist && delta - rest >= ten_k &&
+           (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+    {
+        --digits[length - 1];
+        rest += ten_k;
+    }
+}
+
+inline
+void grisu2_digit_gen(char* digits, int& length, int& exponent,
+                      double_to_decimal_diy_fp m_minus, double_to_decimal_diy_fp w, double_to_decimal_diy_fp m_plus)
+{
+    double_to_decimal_diy_fp delta = m_plus - m_minus;
+    double_to_decimal_diy_fp dist = m_plus - w;
+
+    const int shift = -m_plus.e;
+    const uint64_t one = uint64_t(1) << shift;
+
+    uint32_t p1 = static_cast<uint32_t>(m_plus.f >> shift);
+    uint64_t p2 = m_plus.f & (one - 1);
+
+    int n = 0;
+    uint32_t pow10 = largest_power_of_ten(p1, n);
+
+    while (n > 0)
+    {
+        uint32_t d = p1 / pow10;
+        p1 %= pow10;
+        digits[length++] = static_cast<char>('0' + d);
+        --n;
+
+        uint64_t rest = (static_cast<uint64_t>(p1) << shift) + p2;
+        if (rest <= delta.f)
+        {
+            exponent += n;
+            grisu2_round(digits, length, dist.f, delta.f, rest, static_cast<uint64_t>(pow10) << shift);
+            return;
+        }
+        pow10 /= 10;
+    }
+
+    int m = 0;
+    for (;;)
+    {
+        p2 *= 10;
+        uint64_t d = p2 >> shift;
+        p2 &= one - 1;
+        digits[length++] = static_cast<char>('0' + d);
+        ++m;
+        delta.f *= 10;
+        dist.f *= 10;
+        if (p2 <= delta.f)
+        {
+            break;
+        }
+    }
+    exponent -= m;
+    grisu2_round(digits, length, dist.f, delta.f, p2, one);
+}
+
+// Writes the digits of a positive finite double to digits, which must have
+// room for 17 chars, without a terminating null, and sets length and
+// exponent so that the value is digits times 10^exponent
+
+inline
+void double_to_decimal(double val, char* digits, int& length, int& exponent)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &val, sizeof(double));
+
+    const uint64_t hidden_bit = uint64_t(1) << 52;
+    const uint64_t biased_exponent = bits >> 52;
+    const uint64_t fraction = bits & (hidden_bit - 1);
+
+    double_to_decimal_diy_fp v = biased_exponent == 0
+        ? double_to_decimal_diy_fp(fraction, 1 - 1075)
+        : double_to_decimal_diy_fp(fraction + hidden_bit, static_cast<int>(biased_exponent) - 1075);
+
+    // The boundaries of the interval of numbers that round to val, which is
+    // narrower below when val is a power of 2
+    const bool lower_boundary_is_closer = fraction == 0 && biased_exponent > 1;
+    double_to_decimal_diy_fp m_plus = double_to_decimal_diy_fp(2*v.f + 1, v.e - 1).normalize();
+    double_to_decimal_diy_fp m_minus = lower_boundary_is_closer
+        ? double_to_decimal_diy_fp(4*v.f - 1, v.e - 2)
+        : double_to_decimal_diy_fp(2*v.f - 1, v.e - 1);
+    m_minus = double_to_decimal_diy_fp(m_minus.f << (m_minus.e - m_plus.e), m_plus.e);
+    v = v.normalize();
+
+    const double_to_decimal_cached_power& cached = cached_power_for_binary_exponent(m_plus.e);
+    double_to_decimal_diy_fp c_minus_k(cached.f, cached.e);
+
+    double_to_decimal_diy_fp w = v * c_minus_k;
+    double_to_decimal_diy_fp w_minus = m_minus * c_minus_k;
+    double_to_decimal_diy_fp w_plus = m_plus * c_minus_k;
+
+    // The products may be off by one, so keep inside the interval
+    double_to_decimal_diy_fp lower(w_minus.f + 1, w_minus.e);
+    double_to_decimal_diy_fp upper(w_plus.f - 1, w_plus.e);
+
+    length = 0;
+    exponent = -cached.k;
+    grisu2_digit_gen(digits, length, exponent, lower, w, upper);
+}
+
+}
+
+#endif
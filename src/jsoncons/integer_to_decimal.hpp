@@ -0,0 +1,121 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INTEGER_TO_DECIMAL_HPP
+#define JSONCONS_INTEGER_TO_DECIMAL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/decimal_to_double.hpp>
+
+namespace jsoncons {
+
+// Conversion of integers to decimal text. The number of digits is found
+// from the bit length, and the digits are written from the right two at a
+// time from a table of the pairs 00 to 99.
+
+// The longest decimal text of an int64_t, "-9223372036854775808"
+const size_t integer_to_decimal_max_length = 20;
+
+inline
+const char* integer_to_decimal_digit_pairs()
+{
+    static const char pairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+    return pairs;
+}
+
+inline
+int integer_to_decimal_digit_count(uint64_t value)
+{
+    static const uint64_t powers_of_10[] =
+    {
+        1ull,
+        10ull,
+        100ull,
+        1000ull,
+        10000ull,
+        100000ull,
+        1000000ull,
+        10000000ull,
+        100000000ull,
+        1000000000ull,
+        10000000000ull,
+        100000000000ull,
+        1000000000000ull,
+        10000000000000ull,
+        100000000000000ull,
+        1000000000000000ull,
+        10000000000000000ull,
+        100000000000000000ull,
+        1000000000000000000ull,
+        10000000000000000000ull
+    };
+
+    // Setting the low bit gives 0 one digit and moves no value across a
+    // power of 10. With 1233/4096 approximating log10(2), a value with this
+    // bit length has t or t + 1 digits, t + 1 when it is at least 10^t.
+    uint64_t v = value | 1;
+    int bits = 64 - leading_zeros64(v);
+    int t = (bits * 1233) >> 12;
+    return t + 1 - (v < powers_of_10[t] ? 1 : 0);
+}
+
+// Writes the digits of value to buf, which must have room for
+// integer_to_decimal_max_length characters, and returns the number written
+
+template <class CharT>
+size_t uinteger_to_decimal(uint64_t value, CharT* buf)
+{
+    const char* pairs = integer_to_decimal_digit_pairs();
+    int length = integer_to_decimal_digit_count(value);
+
+    CharT* p = buf + length;
+    while (value >= 100)
+    {
+        unsigned i = static_cast<unsigned>(value % 100) * 2;
+        value /= 100;
+        *--p = static_cast<CharT>(pairs[i + 1]);
+        *--p = static_cast<CharT>(pairs[i]);
+    }
+    if (value >= 10)
+    {
+        unsigned i = static_cast<unsigned>(value) * 2;
+        *--p = static_cast<CharT>(pairs[i + 1]);
+        *--p = static_cast<CharT>(pairs[i]);
+    }
+    else
+    {
+        *--p = static_cast<CharT>('0' + value);
+    }
+    return static_cast<size_t>(length);
+}
+
+template <class CharT>
+size_t integer_to_decimal(int64_t value, CharT* buf)
+{
+    if (value < 0)
+    {
+        *buf = '-';
+        // Negating in unsigned arithmetic is defined for the minimum value
+        return 1 + uinteger_to_decimal(uint64_t(0) - static_cast<uint64_t>(value), buf + 1);
+    }
+    return uinteger_to_decimal(static_cast<uint64_t>(value), buf);
+}
+
+}
+
+#endif
@@ -0,0 +1,376 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INTERNED_KEY_HPP
+#define JSONCONS_INTERNED_KEY_HPP
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <memory>
+#include <atomic>
+#include <iterator>
+#include <cstring>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/jsoncons_util.hpp>
+
+namespace jsoncons {
+
+// basic_interned_key
+
+// An immutable object key that shares its characters with the copies made
+// from it. The characters are held in a single reference counted allocation,
+// so a copy is a pointer copy, and two keys that share characters compare
+// equal without looking at them. The reference count is atomic, so copies
+// may be used and destroyed on different threads.
+
+template <class CharT, class Traits = std::char_traits<CharT>, class Allocator = std::allocator<CharT>>
+class basic_interned_key
+{
+public:
+    typedef CharT value_type;
+    typedef Traits traits_type;
+    typedef Allocator allocator_type;
+    typedef size_t size_type;
+    typedef const CharT* const_iterator;
+    typedef const CharT* iterator;
+#if !defined(JSONCONS_HAS_STRING_VIEW)
+    typedef Basic_string_view_<CharT,Traits> string_view_type;
+#else
+    typedef std::basic_string_view<CharT,Traits> string_view_type;
+#endif
+private:
+    struct node
+    {
+        std::atomic<size_t> count_;
+        size_t length_;
+        allocator_type allocator_;
+
+        node(size_t length, const allocator_type& allocator)
+            : count_(1), length_(length), allocator_(allocator)
+        {
+        }
+
+        // The characters follow the node, sizeof(node) is a multiple of its
+        // alignment, which is at least that of CharT
+        CharT* data()
+        {
+            return reinterpret_cast<CharT*>(this + 1);
+        }
+    };
+
+    struct storage_type
+    {
+        typename std::aligned_storage<sizeof(node), JSONCONS_ALIGNOF(node)>::type data_;
+    };
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<storage_type> storage_allocator_type;
+    typedef typename std::allocator_traits<storage_allocator_type>::pointer storage_pointer;
+
+    // The empty key has no node
+    node* ptr_;
+
+    static size_t storage_count(size_t length)
+    {
+        return (sizeof(node) + (length + 1)*sizeof(CharT) + sizeof(storage_type) - 1)/sizeof(storage_type);
+    }
+
+    void create(const CharT* s, size_t length, const allocator_type& allocator)
+    {
+        if (length == 0)
+        {
+            ptr_ = nullptr;
+            return;
+        }
+        storage_allocator_type alloc(allocator);
+        storage_pointer storage = std::allocator_traits<storage_allocator_type>::allocate(alloc, storage_count(length));
+        ptr_ = new(to_plain_pointer(storage))node(length, allocator);
+        std::memcpy(ptr_->data(), s, length*sizeof(CharT));
+        ptr_->data()[length] = 0;
+    }
+
+    void release()
+    {
+        if (ptr_ != nullptr && ptr_->count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            storage_allocator_type alloc(ptr_->allocator_);
+            size_t count = storage_count(ptr_->length_);
+            ptr_->~node();
+            std::allocator_traits<storage_allocator_type>::deallocate(alloc,
+                std::pointer_traits<storage_pointer>::pointer_to(*reinterpret_cast<storage_type*>(ptr_)), count);
+        }
+        ptr_ = nullptr;
+    }
+public:
+    basic_interned_key() JSONCONS_NOEXCEPT
+        : ptr_(nullptr)
+    {
+    }
+
+    explicit basic_interned_key(const allocator_type&) JSONCONS_NOEXCEPT
+        : ptr_(nullptr)
+    {
+    }
+
+    basic_interned_key(const CharT* s)
+    {
+        create(s, Traits::length(s), allocator_type());
+    }
+
+    basic_interned_key(const CharT* s, size_t length, const allocator_type& allocator = allocator_type())
+    {
+        create(s, length, allocator);
+    }
+
+    template <class InputIt>
+    basic_interned_key(InputIt first, InputIt last, const allocator_type& allocator = allocator_type())
+    {
+        std::basic_string<CharT,Traits> s(first, last);
+        create(s.data(), s.length(), allocator);
+    }
+
+    basic_interned_key(const CharT* first, const CharT* last, const allocator_type& allocator = allocator_type())
+    {
+        create(first, last - first, allocator);
+    }
+
+    template <class SAllocator>
+    basic_interned_key(const std::basic_string<CharT,Traits,SAllocator>& s)
+    {
+        create(s.data(), s.length(), allocator_type());
+    }
+
+    basic_interned_key(const basic_interned_key& other) JSONCONS_NOEXCEPT
+        : ptr_(other.ptr_)
+    {
+        if (ptr_ != nullptr)
+        {
+            ptr_->count_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    basic_interned_key(basic_interned_key&& other) JSONCONS_NOEXCEPT
+        : ptr_(other.ptr_)
+    {
+        other.ptr_ = nullptr;
+    }
+
+    ~basic_interned_key()
+    {
+        release();
+    }
+
+    basic_interned_key& operator=(const basic_interned_key& other) JSONCONS_NOEXCEPT
+    {
+        basic_interned_key temp(other);
+        swap(temp);
+        return *this;
+    }
+
+    basic_interned_key& operator=(basic_interned_key&& other) JSONCONS_NOEXCEPT
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(basic_interned_key& other) JSONCONS_NOEXCEPT
+    {
+        std::swap(ptr_, other.ptr_);
+    }
+
+    const CharT* data() const
+    {
+        static const CharT empty[] = {0};
+        return ptr_ != nullptr ? ptr_->data() : empty;
+    }
+
+    const CharT* c_str() const
+    {
+        return data();
+    }
+
+    size_t size() const
+    {
+        return ptr_ != nullptr ? ptr_->length_ : 0;
+    }
+
+    size_t length() const
+    {
+        return size();
+    }
+
+    bool empty() const
+    {
+        return ptr_ == nullptr;
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + size();
+    }
+
+    allocator_type get_allocator() const
+    {
+        return ptr_ != nullptr ? ptr_->allocator_ : allocator_type();
+    }
+
+    void shrink_to_fit()
+    {
+    }
+
+    // Two keys that share characters are equal
+
+    bool shares_with(const basic_interned_key& other) const
+    {
+        return ptr_ == other.ptr_;
+    }
+
+    int compare(const basic_interned_key& other) const
+    {
+        return ptr_ == other.ptr_ ? 0 : string_view_type(*this).compare(string_view_type(other));
+    }
+
+    int compare(string_view_type s) const
+    {
+        return string_view_type(*this).compare(s);
+    }
+
+    operator string_view_type() const JSONCONS_NOEXCEPT
+    {
+        return string_view_type(data(), size());
+    }
+
+    friend bool operator==(const basic_interned_key& lhs, const basic_interned_key& rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+
+    friend bool operator!=(const basic_interned_key& lhs, const basic_interned_key& rhs)
+    {
+        return lhs.compare(rhs) != 0;
+    }
+
+    friend bool operator<(const basic_interned_key& lhs, const basic_interned_key& rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_interned_key& key)
+    {
+        os.write(key.data(), key.size());
+        return os;
+    }
+};
+
+// key_pool
+
+// Makes the object keys of a json_decoder. For std::basic_string keys every
+// key is a new string. For basic_interned_key, keys are looked up in a table
+// of the keys already made, so that the members with the same name share one
+// copy of it.
+
+template <class KeyT>
+class key_pool
+{
+public:
+    typedef typename KeyT::value_type char_type;
+    typedef typename KeyT::allocator_type allocator_type;
+
+    KeyT make_key(const char_type* s, size_t length, const allocator_type& allocator)
+    {
+        return KeyT(s, s + length, allocator);
+    }
+
+    void clear()
+    {
+    }
+};
+
+template <class CharT, class Traits, class Allocator>
+class key_pool<basic_interned_key<CharT,Traits,Allocator>>
+{
+public:
+    typedef basic_interned_key<CharT,Traits,Allocator> key_type;
+    typedef CharT char_type;
+    typedef Allocator allocator_type;
+
+    // Beyond this many keys, new names are not added to the table, so that a
+    // long lived decoder does not hold on to every distinct name it has seen
+    static const size_t max_keys = 16*1024;
+private:
+    std::vector<key_type> table_;
+    size_t count_;
+
+    void grow()
+    {
+        std::vector<key_type> table(table_.empty() ? 64 : table_.size()*2);
+        for (auto& key : table_)
+        {
+            if (!key.empty())
+            {
+                size_t mask = table.size() - 1;
+                size_t i = hash_string(key.data(), key.size()) & mask;
+                while (!table[i].empty())
+                {
+                    i = (i + 1) & mask;
+                }
+                table[i] = std::move(key);
+            }
+        }
+        table_.swap(table);
+    }
+public:
+    key_pool()
+        : count_(0)
+    {
+    }
+
+    key_type make_key(const CharT* s, size_t length, const allocator_type& allocator)
+    {
+        if (length == 0)
+        {
+            return key_type();
+        }
+        bool full = 2*(count_ + 1) > table_.size();
+        if (full && count_ < max_keys)
+        {
+            grow();
+            full = false;
+        }
+        size_t mask = table_.size() - 1;
+        size_t i = hash_string(s, length) & mask;
+        while (!table_[i].empty())
+        {
+            if (table_[i].size() == length && Traits::compare(table_[i].data(), s, length) == 0)
+            {
+                return table_[i];
+            }
+            i = (i + 1) & mask;
+        }
+        if (full)
+        {
+            // Names already in the table are still shared
+            return key_type(s, length, allocator);
+        }
+        table_[i] = key_type(s, length, allocator);
+        ++count_;
+        return table_[i];
+    }
+
+    void clear()
+    {
+        table_.clear();
+        count_ = 0;
+    }
+};
+
+}
+
+#endif
@@ -17,14 +17,18 @@
 #include <memory>
 #include <typeinfo>
 #include <cstring>
+#include <thread>
+#include <atomic>
 #include <jsoncons/jsoncons.hpp>
 #include <jsoncons/json_traits.hpp>
+#include <jsoncons/arena_allocator.hpp>
 #include <jsoncons/json_container.hpp>
 #include <jsoncons/json_output_handler.hpp>
 #include <jsoncons/serialization_options.hpp>
 #include <jsoncons/json_serializer.hpp>
 #include <jsoncons/json_decoder.hpp>
 #include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_structural_parser.hpp>
 #include <jsoncons/json_type_traits.hpp>
 #include <jsoncons/json_error_category.hpp>
 
@@ -111,12 +115,16 @@ public:
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<json_type> val_allocator_type;
     using array_storage_type = typename json_traits_type::template array_storage<json_type, val_allocator_type>;
 
-    typedef json_array<json_type> array;
+    typedef typename std::conditional<has_packed_arrays<json_traits_type>::value,
+                                      packed_json_array<json_type>,
+                                      json_array<json_type>>::type array;
 
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<kvp_type > kvp_allocator_type;
 
     using object_storage_type = typename json_traits_type::template object_storage<kvp_type , kvp_allocator_type>;
-    typedef json_object<key_storage_type,json_type,json_traits_type::preserve_order> object;
+    typedef typename std::conditional<has_hashed_objects<json_traits_type>::value,
+                                      hashed_json_object<key_storage_type,json_type>,
+                                      json_object<key_storage_type,json_type,json_traits_type::preserve_order>>::type object;
 
 
     typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<array> array_allocator;
@@ -129,7 +137,7 @@ public:
     typedef typename array::iterator array_iterator;
     typedef typename array::const_iterator const_array_iterator;
 
-    struct variant
+    struct standard_variant
     {
         struct base_data
         {
@@ -287,75 +295,39 @@ public:
         };
         struct string_data : public base_data
         {
-            typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<Json_string_<json_type>> string_holder_allocator_type;
-            typedef typename std::allocator_traits<string_holder_allocator_type>::pointer pointer;
+            typedef Json_string_<json_type> string_holder_type;
+            typedef string_holder_type* pointer;
 
             pointer ptr_;
 
-            template <typename... Args>
-            void create(string_holder_allocator_type allocator, Args&& ... args)
-            {
-                typename std::allocator_traits<Allocator>:: template rebind_alloc<Json_string_<json_type>> alloc(allocator);
-                ptr_ = alloc.allocate(1);
-                try
-                {
-                    std::allocator_traits<string_holder_allocator_type>:: template rebind_traits<Json_string_<json_type>>::construct(alloc, to_plain_pointer(ptr_), std::forward<Args>(args)...);
-                }
-                catch (...)
-                {
-                    alloc.deallocate(ptr_,1);
-                    throw;
-                }
-            }
-
-            string_data(const Json_string_<json_type>& val)
-                : base_data(value_type::string_t)
-            {
-                create(val.get_allocator(), val);
-            }
-
             string_data(pointer ptr)
                 : base_data(value_type::string_t)
             {
                 ptr_ = ptr;
             }
 
-            string_data(const Json_string_<json_type>& val, const Allocator& a)
-                : base_data(value_type::string_t)
-            {
-                create(string_holder_allocator_type(a), val, a);
-            }
-
             string_data(const string_data & val)
                 : base_data(value_type::string_t)
             {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
+                ptr_ = string_holder_type::create(val.data(), val.length(),
+                    std::allocator_traits<Allocator>::select_on_container_copy_construction(val.get_allocator()));
             }
 
             string_data(const string_data & val, const Allocator& a)
                 : base_data(value_type::string_t)
             {
-                create(string_holder_allocator_type(a), *(val.ptr_), a);
-            }
-
-            template<class InputIterator>
-            string_data(InputIterator first, InputIterator last, const Allocator& a)
-                : base_data(value_type::string_t)
-            {
-                create(string_holder_allocator_type(a), first, last, a);
+                ptr_ = string_holder_type::create(val.data(), val.length(), a);
             }
 
             string_data(const char_type* data, size_t length, const Allocator& a)
                 : base_data(value_type::string_t)
             {
-                create(string_holder_allocator_type(a), data, length, a);
+                ptr_ = string_holder_type::create(data, length, a);
             }
 
             ~string_data()
             {
-                typename std::allocator_traits<string_holder_allocator_type>:: template rebind_alloc<Json_string_<json_type>> alloc(ptr_->get_allocator());
-                std::allocator_traits<string_holder_allocator_type>:: template rebind_traits<Json_string_<json_type>>::destroy(alloc, to_plain_pointer(ptr_));
-                alloc.deallocate(ptr_,1);
+                string_holder_type::destroy(ptr_);
             }
 
             const char_type* data() const
@@ -548,62 +520,62 @@ public:
 
         data_t data_;
     public:
-        variant()
+        standard_variant()
         {
             new(reinterpret_cast<void*>(&data_))empty_object_data();
         }
 
-        variant(const Allocator& a)
+        standard_variant(const Allocator& a)
         {
             new(reinterpret_cast<void*>(&data_))object_data(a);
         }
 
-        variant(const variant& val)
+        standard_variant(const standard_variant& val)
         {
             Init_(val);
         }
 
-        variant(const variant& val, const Allocator& allocator)
+        standard_variant(const standard_variant& val, const Allocator& allocator)
         {
             Init_(val,allocator);
         }
 
-        variant(variant&& val) JSONCONS_NOEXCEPT
+        standard_variant(standard_variant&& val) JSONCONS_NOEXCEPT
         {
-            Init_rv_(std::forward<variant&&>(val));
+            Init_rv_(std::forward<standard_variant&&>(val));
         }
 
-        variant(variant&& val, const Allocator& allocator) JSONCONS_NOEXCEPT
+        standard_variant(standard_variant&& val, const Allocator& allocator) JSONCONS_NOEXCEPT
         {
-            Init_rv_(std::forward<variant&&>(val), allocator,
+            Init_rv_(std::forward<standard_variant&&>(val), allocator,
                      typename std::allocator_traits<Allocator>::propagate_on_container_move_assignment());
         }
 
-        explicit variant(null_type)
+        explicit standard_variant(null_type)
         {
             new(reinterpret_cast<void*>(&data_))null_data();
         }
-        explicit variant(bool val)
+        explicit standard_variant(bool val)
         {
             new(reinterpret_cast<void*>(&data_))bool_data(val);
         }
-        explicit variant(int64_t val)
+        explicit standard_variant(int64_t val)
         {
             new(reinterpret_cast<void*>(&data_))integer_data(val);
         }
-        explicit variant(uint64_t val)
+        explicit standard_variant(uint64_t val)
         {
             new(reinterpret_cast<void*>(&data_))uinteger_data(val);
         }
-        variant(double val)
+        standard_variant(double val)
         {
             new(reinterpret_cast<void*>(&data_))double_data(val,0);
         }
-        variant(double val, uint8_t precision)
+        standard_variant(double val, uint8_t precision)
         {
             new(reinterpret_cast<void*>(&data_))double_data(val,precision);
         }
-        variant(const char_type* s, size_t length)
+        standard_variant(const char_type* s, size_t length)
         {
             if (length <= small_string_data::max_length)
             {
@@ -614,7 +586,7 @@ public:
                 new(reinterpret_cast<void*>(&data_))string_data(s, length, char_allocator_type());
             }
         }
-        variant(const char_type* s)
+        standard_variant(const char_type* s)
         {
             size_t length = char_traits_type::length(s);
             if (length <= small_string_data::max_length)
@@ -627,7 +599,7 @@ public:
             }
         }
 
-        variant(const char_type* s, const Allocator& alloc)
+        standard_variant(const char_type* s, const Allocator& alloc)
         {
             size_t length = char_traits_type::length(s);
             if (length <= small_string_data::max_length)
@@ -640,7 +612,7 @@ public:
             }
         }
 
-        variant(const char_type* s, size_t length, const Allocator& alloc)
+        standard_variant(const char_type* s, size_t length, const Allocator& alloc)
         {
             if (length <= small_string_data::max_length)
             {
@@ -651,29 +623,29 @@ public:
                 new(reinterpret_cast<void*>(&data_))string_data(s, length, alloc);
             }
         }
-        variant(const object& val)
+        standard_variant(const object& val)
         {
             new(reinterpret_cast<void*>(&data_))object_data(val);
         }
-        variant(const object& val, const Allocator& alloc)
+        standard_variant(const object& val, const Allocator& alloc)
         {
             new(reinterpret_cast<void*>(&data_))object_data(val, alloc);
         }
-        variant(const array& val)
+        standard_variant(const array& val)
         {
             new(reinterpret_cast<void*>(&data_))array_data(val);
         }
-        variant(const array& val, const Allocator& alloc)
+        standard_variant(const array& val, const Allocator& alloc)
         {
             new(reinterpret_cast<void*>(&data_))array_data(val,alloc);
         }
         template<class InputIterator>
-        variant(InputIterator first, InputIterator last, const Allocator& a)
+        standard_variant(InputIterator first, InputIterator last, const Allocator& a)
         {
             new(reinterpret_cast<void*>(&data_))array_data(first, last, a);
         }
 
-        ~variant()
+        ~standard_variant()
         {
             Destroy_();
         }
@@ -696,7 +668,7 @@ public:
             }
         }
 
-        variant& operator=(const variant& val)
+        standard_variant& operator=(const standard_variant& val)
         {
             if (this != &val)
             {
@@ -740,7 +712,7 @@ public:
             return *this;
         }
 
-        variant& operator=(variant&& val) JSONCONS_NOEXCEPT
+        standard_variant& operator=(standard_variant&& val) JSONCONS_NOEXCEPT
         {
             if (this != &val)
             {
@@ -834,7 +806,7 @@ public:
             }
         }
 
-        bool operator==(const variant& rhs) const
+        bool operator==(const standard_variant& rhs) const
         {
             if (this == &rhs)
             {
@@ -927,12 +899,12 @@ public:
             return false;
         }
 
-        bool operator!=(const variant& rhs) const
+        bool operator!=(const standard_variant& rhs) const
         {
             return !(*this == rhs);
         }
 
-        void swap(variant& rhs) JSONCONS_NOEXCEPT
+        void swap(standard_variant& rhs) JSONCONS_NOEXCEPT
         {
             if (this != &rhs)
             {
@@ -1171,7 +1143,7 @@ public:
         }
     private:
 
-        void Init_(const variant& val)
+        void Init_(const standard_variant& val)
         {
             switch (val.type_id())
             {
@@ -1210,7 +1182,7 @@ public:
             }
         }
 
-        void Init_(const variant& val, const Allocator& a)
+        void Init_(const standard_variant& val, const Allocator& a)
         {
             switch (val.type_id())
             {
@@ -1237,7 +1209,7 @@ public:
             }
         }
 
-        void Init_rv_(variant&& val) JSONCONS_NOEXCEPT
+        void Init_rv_(standard_variant&& val) JSONCONS_NOEXCEPT
         {
             switch (val.type_id())
             {
@@ -1273,12 +1245,12 @@ public:
             }
         }
 
-        void Init_rv_(variant&& val, const Allocator& a, std::true_type) JSONCONS_NOEXCEPT
+        void Init_rv_(standard_variant&& val, const Allocator& a, std::true_type) JSONCONS_NOEXCEPT
         {
-            Init_rv_(std::forward<variant&&>(val));
+            Init_rv_(std::forward<standard_variant&&>(val));
         }
 
-        void Init_rv_(variant&& val, const Allocator& a, std::false_type) JSONCONS_NOEXCEPT
+        void Init_rv_(standard_variant&& val, const Allocator& a, std::false_type) JSONCONS_NOEXCEPT
         {
             switch (val.type_id())
             {
@@ -1289,13 +1261,13 @@ public:
             case value_type::uinteger_t:
             case value_type::bool_t:
             case value_type::small_string_t:
-                Init_(std::forward<variant&&>(val));
+                Init_(std::forward<standard_variant&&>(val));
                 break;
             case value_type::string_t:
                 {
                     if (a == val.string_data_cast()->get_allocator())
                     {
-                        Init_rv_(std::forward<variant&&>(val), a, std::true_type());
+                        Init_rv_(std::forward<standard_variant&&>(val), a, std::true_type());
                     }
                     else
                     {
@@ -1307,7 +1279,19 @@ public:
                 {
                     if (a == val.object_data_cast()->get_allocator())
                     {
-                        Init_rv_(std::forward<variant&&>(val), a, std::true_type());
+                        Init_rv_(std::forward<standard_variant&&>(val), a, std::true_type());
+                    }
+                    else
+                    {
+                        Init_(val,a);
+                    }
+                }
+                break;
+            case value_type::array_t:
+                {
+                    if (a == val.array_data_cast()->get_allocator())
+                    {
+                        Init_rv_(std::forward<standard_variant&&>(val), a, std::true_type());
                     }
                     else
                     {
@@ -1315,24 +1299,774 @@ public:
                     }
                 }
                 break;
-            case value_type::array_t:
+            default:
+                break;
+            }
+        }
+    };
+
+    // compact_variant
+
+    // The layout of values for traits that declare compact_values, on 64-bit
+    // platforms. A value is one 64-bit word. If the word is not one of the
+    // NaN bit patterns listed below, it is a double, with every NaN stored
+    // as one quiet NaN. Otherwise its top 16 bits are a tag and its low 48
+    // bits hold a literal, an integer that fits in 48 bits, a short string,
+    // or a pointer to a long string, an object, an array or a boxed integer.
+    // Doubles do not keep a precision. Pointers must fit in 48 bits, as user
+    // space addresses do on x86-64 and AArch64.
+
+    struct compact_variant
+    {
+        static const uint64_t payload_mask = 0x0000FFFFFFFFFFFFull;
+        static const uint64_t canonical_nan = 0x7FF8000000000000ull;
+
+        static const uint16_t literal_tag = 0xFFF9;
+        static const uint16_t integer_tag = 0xFFFA;
+        static const uint16_t uinteger_tag = 0xFFFB;
+        static const uint16_t string_tag = 0xFFFC;
+        static const uint16_t object_tag = 0xFFFD;
+        static const uint16_t array_tag = 0xFFFE;
+        static const uint16_t small_string_tag = 0xFFFF;
+        static const uint16_t boxed_integer_tag = 0x7FF9;
+        static const uint16_t boxed_uinteger_tag = 0x7FFA;
+
+        static const uint64_t null_literal = 0;
+        static const uint64_t false_literal = 1;
+        static const uint64_t true_literal = 2;
+        static const uint64_t empty_object_literal = 3;
+
+        // Short strings are kept in the payload, the characters and a
+        // terminating null in its first 5 bytes and the length in the last
+
+#if defined(JSONCONS_BIG_ENDIAN)
+        static const size_t payload_offset = 2;
+#else
+        static const size_t payload_offset = 0;
+#endif
+        static const size_t small_string_capacity = 5/sizeof(char_type);
+        static const size_t small_string_max_length = small_string_capacity - 1;
+
+        typedef Json_string_<json_type> string_holder_type;
+
+        struct number_box
+        {
+            allocator_type allocator_;
+            uint64_t val_;
+
+            number_box(uint64_t val, const allocator_type& allocator)
+                : allocator_(allocator), val_(val)
+            {
+            }
+        };
+        typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<number_box> box_allocator;
+
+        // The data casts return these by value, they can be used like the
+        // pointers returned by the data casts of standard_variant
+
+        template <class T>
+        struct scalar_data
+        {
+            T val_;
+
+            T value() const
+            {
+                return val_;
+            }
+
+            uint8_t precision() const
+            {
+                return 0;
+            }
+
+            const scalar_data* operator->() const
+            {
+                return this;
+            }
+        };
+
+        struct small_string_data
+        {
+            const char_type* data_;
+            uint8_t length_;
+
+            uint8_t length() const
+            {
+                return length_;
+            }
+
+            const char_type* data() const
+            {
+                return data_;
+            }
+
+            const char_type* c_str() const
+            {
+                return data_;
+            }
+
+            const small_string_data* operator->() const
+            {
+                return this;
+            }
+        };
+
+        struct string_data
+        {
+            string_holder_type* ptr_;
+
+            const char_type* data() const
+            {
+                return ptr_->data();
+            }
+
+            const char_type* c_str() const
+            {
+                return ptr_->c_str();
+            }
+
+            size_t length() const
+            {
+                return ptr_->length();
+            }
+
+            allocator_type get_allocator() const
+            {
+                return ptr_->get_allocator();
+            }
+
+            const string_data* operator->() const
+            {
+                return this;
+            }
+        };
+
+        template <class T>
+        struct container_data
+        {
+            T* ptr_;
+
+            T& value() const
+            {
+                return *ptr_;
+            }
+
+            allocator_type get_allocator() const
+            {
+                return ptr_->get_allocator();
+            }
+
+            const container_data* operator->() const
+            {
+                return this;
+            }
+        };
+    private:
+        uint64_t bits_;
+    public:
+        compact_variant()
+            : bits_(literal(empty_object_literal))
+        {
+        }
+
+        compact_variant(const Allocator& a)
+            : bits_(literal(null_literal))
+        {
+            set_pointer(object_tag, create<object>(object_allocator(a), a));
+        }
+
+        compact_variant(const compact_variant& val)
+            : bits_(literal(null_literal))
+        {
+            Init_(val);
+        }
+
+        compact_variant(const compact_variant& val, const Allocator& allocator)
+            : bits_(literal(null_literal))
+        {
+            Init_(val,allocator);
+        }
+
+        compact_variant(compact_variant&& val) JSONCONS_NOEXCEPT
+            : bits_(val.bits_)
+        {
+            val.bits_ = literal(null_literal);
+        }
+
+        compact_variant(compact_variant&& val, const Allocator& allocator) JSONCONS_NOEXCEPT
+            : bits_(literal(null_literal))
+        {
+            Init_rv_(std::forward<compact_variant&&>(val), allocator,
+                     typename std::allocator_traits<Allocator>::propagate_on_container_move_assignment());
+        }
+
+        explicit compact_variant(null_type)
+            : bits_(literal(null_literal))
+        {
+        }
+        explicit compact_variant(bool val)
+            : bits_(literal(val ? true_literal : false_literal))
+        {
+        }
+        explicit compact_variant(int64_t val)
+            : bits_(literal(null_literal))
+        {
+            if (val >= -static_cast<int64_t>(payload_mask/2) - 1 && val <= static_cast<int64_t>(payload_mask/2))
+            {
+                bits_ = tagged(integer_tag, static_cast<uint64_t>(val) & payload_mask);
+            }
+            else
+            {
+                set_pointer(boxed_integer_tag, create_box(static_cast<uint64_t>(val), Allocator()));
+            }
+        }
+        explicit compact_variant(uint64_t val)
+            : bits_(literal(null_literal))
+        {
+            if (val <= payload_mask)
+            {
+                bits_ = tagged(uinteger_tag, val);
+            }
+            else
+            {
+                set_pointer(boxed_uinteger_tag, create_box(val, Allocator()));
+            }
+        }
+        compact_variant(double val)
+        {
+            if (val != val)
+            {
+                bits_ = canonical_nan;
+            }
+            else
+            {
+                std::memcpy(&bits_, &val, sizeof(double));
+            }
+        }
+        compact_variant(double val, uint8_t)
+            : compact_variant(val)
+        {
+        }
+        compact_variant(const char_type* s, size_t length)
+            : bits_(literal(null_literal))
+        {
+            Init_string_(s, length, Allocator());
+        }
+        compact_variant(const char_type* s)
+            : bits_(literal(null_literal))
+        {
+            Init_string_(s, char_traits_type::length(s), Allocator());
+        }
+
+        compact_variant(const char_type* s, const Allocator& alloc)
+            : bits_(literal(null_literal))
+        {
+            Init_string_(s, char_traits_type::length(s), alloc);
+        }
+
+        compact_variant(const char_type* s, size_t length, const Allocator& alloc)
+            : bits_(literal(null_literal))
+        {
+            Init_string_(s, length, alloc);
+        }
+        compact_variant(const object& val)
+            : bits_(literal(null_literal))
+        {
+            set_pointer(object_tag, create<object>(val.get_allocator(), val));
+        }
+        compact_variant(const object& val, const Allocator& alloc)
+            : bits_(literal(null_literal))
+        {
+            set_pointer(object_tag, create<object>(object_allocator(alloc), val, alloc));
+        }
+        compact_variant(const array& val)
+            : bits_(literal(null_literal))
+        {
+            set_pointer(array_tag, create<array>(val.get_allocator(), val));
+        }
+        compact_variant(const array& val, const Allocator& alloc)
+            : bits_(literal(null_literal))
+        {
+            set_pointer(array_tag, create<array>(array_allocator(alloc), val, alloc));
+        }
+        template<class InputIterator>
+        compact_variant(InputIterator first, InputIterator last, const Allocator& a)
+            : bits_(literal(null_literal))
+        {
+            set_pointer(array_tag, create<array>(array_allocator(a), first, last, a));
+        }
+
+        ~compact_variant()
+        {
+            Destroy_();
+        }
+
+        void Destroy_()
+        {
+            switch (tag())
+            {
+            case string_tag:
+                string_holder_type::destroy(pointer<string_holder_type>());
+                break;
+            case object_tag:
+                destroy(pointer<object>());
+                break;
+            case array_tag:
+                destroy(pointer<array>());
+                break;
+            case boxed_integer_tag:
+            case boxed_uinteger_tag:
+                destroy(pointer<number_box>());
+                break;
+            default:
+                break;
+            }
+        }
+
+        compact_variant& operator=(const compact_variant& val)
+        {
+            if (this != &val)
+            {
+                Destroy_();
+                bits_ = literal(null_literal);
+                Init_(val);
+            }
+            return *this;
+        }
+
+        compact_variant& operator=(compact_variant&& val) JSONCONS_NOEXCEPT
+        {
+            if (this != &val)
+            {
+                Destroy_();
+                bits_ = literal(null_literal);
+                swap(val);
+            }
+            return *this;
+        }
+
+        value_type type_id() const
+        {
+            if ((tag() & 0x7FFF) < 0x7FF9)
+            {
+                return value_type::double_t;
+            }
+            switch (tag())
+            {
+            case literal_tag:
+                switch (payload())
+                {
+                case null_literal:
+                    return value_type::null_t;
+                case empty_object_literal:
+                    return value_type::empty_object_t;
+                default:
+                    return value_type::bool_t;
+                }
+            case integer_tag:
+            case boxed_integer_tag:
+                return value_type::integer_t;
+            case uinteger_tag:
+            case boxed_uinteger_tag:
+                return value_type::uinteger_t;
+            case string_tag:
+                return value_type::string_t;
+            case small_string_tag:
+                return value_type::small_string_t;
+            case object_tag:
+                return value_type::object_t;
+            default:
+                return value_type::array_t;
+            }
+        }
+
+        scalar_data<bool> bool_data_cast() const
+        {
+            return scalar_data<bool>{payload() == true_literal};
+        }
+
+        scalar_data<int64_t> integer_data_cast() const
+        {
+            return scalar_data<int64_t>{integer_value()};
+        }
+
+        scalar_data<uint64_t> uinteger_data_cast() const
+        {
+            return scalar_data<uint64_t>{uinteger_value()};
+        }
+
+        scalar_data<double> double_data_cast() const
+        {
+            return scalar_data<double>{double_value()};
+        }
+
+        small_string_data small_string_data_cast() const
+        {
+            const char* p = reinterpret_cast<const char*>(&bits_) + payload_offset;
+            return small_string_data{reinterpret_cast<const char_type*>(p), static_cast<uint8_t>(p[5])};
+        }
+
+        string_data string_data_cast() const
+        {
+            return string_data{pointer<string_holder_type>()};
+        }
+
+        container_data<object> object_data_cast()
+        {
+            return container_data<object>{pointer<object>()};
+        }
+
+        container_data<const object> object_data_cast() const
+        {
+            return container_data<const object>{pointer<object>()};
+        }
+
+        container_data<array> array_data_cast()
+        {
+            return container_data<array>{pointer<array>()};
+        }
+
+        container_data<const array> array_data_cast() const
+        {
+            return container_data<const array>{pointer<array>()};
+        }
+
+        string_view_type as_string_view() const
+        {
+            switch (tag())
+            {
+            case small_string_tag:
+                {
+                    auto data = small_string_data_cast();
+                    return string_view_type(data.data(),data.length());
+                }
+            case string_tag:
+                {
+                    auto data = string_data_cast();
+                    return string_view_type(data.data(),data.length());
+                }
+            default:
+                JSONCONS_THROW_EXCEPTION(std::runtime_error,"Not a string");
+            }
+        }
+
+        bool operator==(const compact_variant& rhs) const
+        {
+            if (this == &rhs)
+            {
+                return true;
+            }
+
+            const value_type id = type_id();
+            const value_type rhs_id = rhs.type_id();
+
+            if (id == rhs_id)
+            {
+                switch (id)
+                {
+                case value_type::null_t:
+                case value_type::empty_object_t:
+                    return true;
+                case value_type::double_t:
+                    return double_value() == rhs.double_value();
+                case value_type::integer_t:
+                    return integer_value() == rhs.integer_value();
+                case value_type::uinteger_t:
+                    return uinteger_value() == rhs.uinteger_value();
+                case value_type::bool_t:
+                    return bits_ == rhs.bits_;
+                case value_type::small_string_t:
+                case value_type::string_t:
+                    return as_string_view() == rhs.as_string_view();
+                case value_type::object_t:
+                    return *pointer<object>() == *rhs.pointer<object>();
+                case value_type::array_t:
+                    return *pointer<array>() == *rhs.pointer<array>();
+                default:
+                    return false;
+                }
+            }
+
+            switch (id)
+            {
+            case value_type::integer_t:
+                if (rhs_id == value_type::double_t)
+                {
+                    return static_cast<double>(integer_value()) == rhs.double_value();
+                }
+                else if (rhs_id == value_type::uinteger_t && integer_value() >= 0)
+                {
+                    return static_cast<uint64_t>(integer_value()) == rhs.uinteger_value();
+                }
+                break;
+            case value_type::uinteger_t:
+                if (rhs_id == value_type::double_t)
+                {
+                    return static_cast<double>(uinteger_value()) == rhs.double_value();
+                }
+                else if (rhs_id == value_type::integer_t && rhs.integer_value() >= 0)
+                {
+                    return uinteger_value() == static_cast<uint64_t>(rhs.integer_value());
+                }
+                break;
+            case value_type::double_t:
+                if (rhs_id == value_type::integer_t)
+                {
+                    return double_value() == static_cast<double>(rhs.integer_value());
+                }
+                else if (rhs_id == value_type::uinteger_t)
+                {
+                    return double_value() == static_cast<double>(rhs.uinteger_value());
+                }
+                break;
+            case value_type::empty_object_t:
+                if (rhs_id == value_type::object_t && rhs.pointer<object>()->size() == 0)
+                {
+                    return true;
+                }
+                break;
+            case value_type::object_t:
+                if (rhs_id == value_type::empty_object_t && pointer<object>()->size() == 0)
+                {
+                    return true;
+                }
+                break;
+            case value_type::small_string_t:
+            case value_type::string_t:
+                return as_string_view() == rhs.as_string_view();
+            default:
+                break;
+            }
+            
+            return false;
+        }
+
+        bool operator!=(const compact_variant& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+        void swap(compact_variant& rhs) JSONCONS_NOEXCEPT
+        {
+            std::swap(bits_, rhs.bits_);
+        }
+    private:
+        static uint64_t tagged(uint16_t tag, uint64_t payload)
+        {
+            return (static_cast<uint64_t>(tag) << 48) | payload;
+        }
+
+        static uint64_t literal(uint64_t val)
+        {
+            return tagged(literal_tag, val);
+        }
+
+        // Every bit pattern that is not a tag is a double
+
+        uint16_t tag() const
+        {
+            return static_cast<uint16_t>(bits_ >> 48);
+        }
+
+        uint64_t payload() const
+        {
+            return bits_ & payload_mask;
+        }
+
+        int64_t integer_value() const
+        {
+            if (tag() == boxed_integer_tag)
+            {
+                return static_cast<int64_t>(pointer<number_box>()->val_);
+            }
+            return static_cast<int64_t>(bits_ << 16) >> 16;
+        }
+
+        uint64_t uinteger_value() const
+        {
+            if (tag() == boxed_uinteger_tag)
+            {
+                return pointer<number_box>()->val_;
+            }
+            return payload();
+        }
+
+        double double_value() const
+        {
+            double val;
+            std::memcpy(&val, &bits_, sizeof(double));
+            return val;
+        }
+
+        template <class T>
+        T* pointer() const
+        {
+            return reinterpret_cast<T*>(static_cast<uintptr_t>(payload()));
+        }
+
+        template <class T>
+        void set_pointer(uint16_t tag, T* ptr)
+        {
+            uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+            JSONCONS_ASSERT((address & ~payload_mask) == 0);
+            bits_ = tagged(tag, address);
+        }
+
+        template <class T, class Alloc, typename... Args>
+        static T* create(Alloc alloc, Args&& ... args)
+        {
+            typedef typename std::allocator_traits<Alloc>:: template rebind_alloc<T> allocator;
+            typedef std::allocator_traits<allocator> traits;
+            static_assert(std::is_pointer<typename traits::pointer>::value,
+                          "The compact layout requires allocators with plain pointers");
+            allocator a(alloc);
+            T* ptr = traits::allocate(a, 1);
+            try
+            {
+                traits::construct(a, ptr, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                traits::deallocate(a, ptr, 1);
+                throw;
+            }
+            return ptr;
+        }
+
+        template <class T>
+        static void destroy(T* ptr)
+        {
+            typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<T> allocator;
+            allocator a(ptr->get_allocator());
+            std::allocator_traits<allocator>::destroy(a, ptr);
+            std::allocator_traits<allocator>::deallocate(a, ptr, 1);
+        }
+
+        static void destroy(number_box* ptr)
+        {
+            box_allocator a(ptr->allocator_);
+            std::allocator_traits<box_allocator>::destroy(a, ptr);
+            std::allocator_traits<box_allocator>::deallocate(a, ptr, 1);
+        }
+
+        static number_box* create_box(uint64_t val, const Allocator& a)
+        {
+            return create<number_box>(a, val, a);
+        }
+
+        void Init_string_(const char_type* s, size_t length, const Allocator& a)
+        {
+            if (length <= small_string_max_length)
+            {
+                bits_ = tagged(small_string_tag, 0);
+                char* p = reinterpret_cast<char*>(&bits_) + payload_offset;
+                std::memcpy(p, s, length*sizeof(char_type));
+                p[5] = static_cast<char>(length);
+            }
+            else
+            {
+                set_pointer(string_tag, string_holder_type::create(s, length, a));
+            }
+        }
+
+        void Init_(const compact_variant& val)
+        {
+            switch (val.tag())
+            {
+            case string_tag:
+                {
+                    auto data = val.string_data_cast();
+                    set_pointer(string_tag, string_holder_type::create(data.data(), data.length(),
+                        std::allocator_traits<Allocator>::select_on_container_copy_construction(data.get_allocator())));
+                }
+                break;
+            case object_tag:
+                set_pointer(object_tag, create<object>(val.pointer<object>()->get_allocator(), *val.pointer<object>()));
+                break;
+            case array_tag:
+                set_pointer(array_tag, create<array>(val.pointer<array>()->get_allocator(), *val.pointer<array>()));
+                break;
+            case boxed_integer_tag:
+            case boxed_uinteger_tag:
+                set_pointer(val.tag(), create_box(val.pointer<number_box>()->val_, val.pointer<number_box>()->allocator_));
+                break;
+            default:
+                bits_ = val.bits_;
+                break;
+            }
+        }
+
+        void Init_(const compact_variant& val, const Allocator& a)
+        {
+            switch (val.tag())
+            {
+            case string_tag:
                 {
-                    if (a == val.array_data_cast()->get_allocator())
-                    {
-                        Init_rv_(std::forward<variant&&>(val), a, std::true_type());
-                    }
-                    else
-                    {
-                        Init_(val,a);
-                    }
+                    auto data = val.string_data_cast();
+                    set_pointer(string_tag, string_holder_type::create(data.data(), data.length(), a));
                 }
                 break;
+            case object_tag:
+                set_pointer(object_tag, create<object>(object_allocator(a), *val.pointer<object>(), a));
+                break;
+            case array_tag:
+                set_pointer(array_tag, create<array>(array_allocator(a), *val.pointer<array>(), a));
+                break;
+            case boxed_integer_tag:
+            case boxed_uinteger_tag:
+                set_pointer(val.tag(), create_box(val.pointer<number_box>()->val_, a));
+                break;
+            default:
+                bits_ = val.bits_;
+                break;
+            }
+        }
+
+        void Init_rv_(compact_variant&& val, const Allocator&, std::true_type) JSONCONS_NOEXCEPT
+        {
+            swap(val);
+        }
+
+        void Init_rv_(compact_variant&& val, const Allocator& a, std::false_type) JSONCONS_NOEXCEPT
+        {
+            switch (val.tag())
+            {
+            case string_tag:
+                move_or_copy(val, a, val.string_data_cast().get_allocator());
+                break;
+            case object_tag:
+                move_or_copy(val, a, val.pointer<object>()->get_allocator());
+                break;
+            case array_tag:
+                move_or_copy(val, a, val.pointer<array>()->get_allocator());
+                break;
+            case boxed_integer_tag:
+            case boxed_uinteger_tag:
+                move_or_copy(val, a, val.pointer<number_box>()->allocator_);
+                break;
             default:
+                swap(val);
                 break;
             }
         }
+
+        void move_or_copy(compact_variant& val, const Allocator& a, const Allocator& val_allocator)
+        {
+            if (a == val_allocator)
+            {
+                swap(val);
+            }
+            else
+            {
+                Init_(val,a);
+            }
+        }
     };
 
+    typedef typename std::conditional<has_compact_values<json_traits_type>::value && sizeof(void*) == 8,
+                                      compact_variant,
+                                      standard_variant>::type variant;
+
     template <class ParentT>
     class json_proxy 
     {
@@ -1999,6 +2733,30 @@ public:
         return handler.get_result();
     }
 
+    static basic_json parse(string_view_type s, parse_engine engine)
+    {
+        parse_error_handler_type err_handler;
+        return parse(s,err_handler,engine);
+    }
+
+    static basic_json parse(string_view_type s, basic_parse_error_handler<char_type>& err_handler, parse_engine engine)
+    {
+        if (engine != parse_engine::incremental && s.length() <= basic_structural_index<char_type>::max_length())
+        {
+            // Input the structural parser rejects is parsed again by the incremental 
+            // parser, which reports the error position and can recover from errors
+            try
+            {
+                return engine == parse_engine::parallel ? parse_parallel(s.data(),s.length()) 
+                                                        : parse_structural(s.data(),s.length());
+            }
+            catch (const parse_exception&)
+            {
+            }
+        }
+        return parse(s,err_handler);
+    }
+
     static basic_json parse(const char_type* s, size_t length, basic_parse_error_handler<char_type>& err_handler)
     {
         json_decoder<json_type> handler;
@@ -2015,6 +2773,31 @@ public:
         return handler.get_result();
     }
 
+    // Builds every value of the result with allocator, for example an
+    // arena_allocator that takes its memory from an arena
+
+    static basic_json parse(string_view_type s, const allocator_type& allocator)
+    {
+        parse_error_handler_type err_handler;
+        return parse(s,err_handler,allocator);
+    }
+
+    static basic_json parse(string_view_type s, basic_parse_error_handler<char_type>& err_handler, const allocator_type& allocator)
+    {
+        json_decoder<json_type> handler(char_allocator_type(allocator),allocator);
+        basic_json_parser<char_type> parser(handler,err_handler);
+        parser.set_source(s.data(),s.length());
+        parser.skip_bom();
+        parser.parse();
+        parser.end_parse();
+        parser.check_done();
+        if (!handler.is_valid())
+        {
+            JSONCONS_THROW_EXCEPTION(std::runtime_error,"Failed to parse json string");
+        }
+        return handler.get_result();
+    }
+
     static basic_json parse_file(const std::basic_string<char_type,char_traits_type>& filename)
     {
         parse_error_handler_type err_handler;
@@ -2023,6 +2806,19 @@ public:
 
     static basic_json parse_file(const std::basic_string<char_type,char_traits_type>& filename,
                                  basic_parse_error_handler<char_type>& err_handler)
+    {
+        return parse_file(filename,err_handler,parse_engine::incremental);
+    }
+
+    static basic_json parse_file(const std::basic_string<char_type,char_traits_type>& filename, parse_engine engine)
+    {
+        parse_error_handler_type err_handler;
+        return parse_file(filename,err_handler,engine);
+    }
+
+    static basic_json parse_file(const std::basic_string<char_type,char_traits_type>& filename,
+                                 basic_parse_error_handler<char_type>& err_handler,
+                                 parse_engine engine)
     {
         FILE* fp;
 
@@ -2040,7 +2836,7 @@ public:
         }
     #endif
 
-        json_decoder<basic_json<CharT,JsonTraits,Allocator>> handler;
+        std::vector<char_type> buffer;
         try
         {
             // obtain file size:
@@ -2050,7 +2846,7 @@ public:
 
             if (size > 0)
             {
-                std::vector<char_type> buffer(size);
+                buffer.resize(size);
 
                 // copy the file into the buffer:
                 size_t result = std::fread (buffer.data(),1,size,fp);
@@ -2058,13 +2854,6 @@ public:
                 {
                     JSONCONS_THROW_EXCEPTION_1(std::runtime_error,"Error reading file %s", filename);
                 }
-
-                basic_json_parser<char_type> parser(handler,err_handler);
-                parser.set_source(buffer.data(),buffer.size());
-                parser.skip_bom();
-                parser.parse();
-                parser.end_parse();
-                parser.check_done();
             }
 
             std::fclose (fp);
@@ -2074,6 +2863,29 @@ public:
             std::fclose (fp);
             throw;
         }
+
+        json_decoder<basic_json<CharT,JsonTraits,Allocator>> handler;
+        if (buffer.size() > 0)
+        {
+            if (engine != parse_engine::incremental && buffer.size() <= basic_structural_index<char_type>::max_length())
+            {
+                try
+                {
+                    return engine == parse_engine::parallel ? parse_parallel(buffer.data(),buffer.size()) 
+                                                            : parse_structural(buffer.data(),buffer.size());
+                }
+                catch (const parse_exception&)
+                {
+                }
+            }
+
+            basic_json_parser<char_type> parser(handler,err_handler);
+            parser.set_source(buffer.data(),buffer.size());
+            parser.skip_bom();
+            parser.parse();
+            parser.end_parse();
+            parser.check_done();
+        }
         if (!handler.is_valid())
         {
             JSONCONS_THROW_EXCEPTION(std::runtime_error,"Failed to parse json file");
@@ -2345,26 +3157,20 @@ public:
     template <class SAllocator>
     void dump(std::basic_string<char_type,char_traits_type,SAllocator>& s) const
     {
-        std::basic_ostringstream<char_type,char_traits_type,SAllocator> os;
-        os.imbue(std::locale::classic());
-        {
-            basic_json_serializer<char_type> serializer(os);
-            dump(serializer);
-        }
-        s = os.str();
+        typedef std::basic_string<char_type,char_traits_type,SAllocator> target_type;
+        s.clear();
+        basic_json_serializer<char_type,string_sink<target_type>> serializer(s);
+        dump(serializer);
     }
 
     template <class SAllocator>
     void dump(std::basic_string<char_type,char_traits_type,SAllocator>& s,
               const basic_serialization_options<char_type>& options) const
     {
-        std::basic_ostringstream<char_type,char_traits_type,SAllocator> os;
-        os.imbue(std::locale::classic());
-        {
-            basic_json_serializer<char_type> serializer(os,options);
-            dump(serializer);
-        }
-        s = os.str();
+        typedef std::basic_string<char_type,char_traits_type,SAllocator> target_type;
+        s.clear();
+        basic_json_serializer<char_type,string_sink<target_type>> serializer(s,options);
+        dump(serializer);
     }
 
     void dump_body(basic_json_output_handler<char_type>& handler) const
@@ -2410,9 +3216,26 @@ public:
             {
                 handler.begin_array();
                 const array& o = array_value();
-                for (const_array_iterator it = o.begin(); it != o.end(); ++it)
+                switch (o.packing())
                 {
-                    it->dump_body(handler);
+                case array_packing::doubles:
+                    for (size_t i = 0; i < o.size(); ++i)
+                    {
+                        handler.value(o.packed_doubles()[i], o.packed_precisions()[i]);
+                    }
+                    break;
+                case array_packing::integers:
+                    for (size_t i = 0; i < o.size(); ++i)
+                    {
+                        handler.value(o.packed_integers()[i]);
+                    }
+                    break;
+                default:
+                    for (const_array_iterator it = o.begin(); it != o.end(); ++it)
+                    {
+                        it->dump_body(handler);
+                    }
+                    break;
                 }
                 handler.end_array();
             }
@@ -2451,26 +3274,22 @@ public:
     string_type to_string(const char_allocator_type& allocator=char_allocator_type()) const JSONCONS_NOEXCEPT
     {
         string_type s(allocator);
-        std::basic_ostringstream<char_type,char_traits_type,char_allocator_type> os(s);
-        os.imbue(std::locale::classic());
         {
-            basic_json_serializer<char_type> serializer(os);
+            basic_json_serializer<char_type,string_sink<string_type>> serializer(s);
             dump_body(serializer);
         }
-        return os.str();
+        return s;
     }
 
     string_type to_string(const basic_serialization_options<char_type>& options,
                           const char_allocator_type& allocator=char_allocator_type()) const
     {
         string_type s(allocator);
-        std::basic_ostringstream<char_type> os(s);
-        os.imbue(std::locale::classic());
         {
-            basic_json_serializer<char_type> serializer(os, options);
+            basic_json_serializer<char_type,string_sink<string_type>> serializer(s, options);
             dump_body(serializer);
         }
-        return os.str();
+        return s;
     }
 
     void write_body(basic_json_output_handler<char_type>& handler) const
@@ -3792,6 +4611,161 @@ public:
 
 private:
 
+    static basic_json parse_structural(const char_type* s, size_t length)
+    {
+        json_decoder<json_type> handler;
+        basic_json_structural_parser<char_type> parser(handler);
+        parser.parse(s,length);
+        if (!handler.is_valid())
+        {
+            JSONCONS_THROW_EXCEPTION(std::runtime_error,"Failed to parse json string");
+        }
+        return handler.get_result();
+    }
+
+    // A top-level array is split at the commas between its elements into about 
+    // four ranges per thread, of about equal length, and each range is parsed
+    // into an array by a structural parser that walks a shared index. The
+    // arrays are then joined. Anything else is parsed by parse_structural.
+
+    static basic_json parse_parallel(const char_type* s, size_t length)
+    {
+        static const size_t min_parallel_length = 1024*1024;
+
+        size_t num_threads = std::thread::hardware_concurrency();
+        auto bom = unicons::skip_bom(s, s + length);
+        if (num_threads <= 1 || length < min_parallel_length || bom.first != unicons::encoding_errc::ok)
+        {
+            return parse_structural(s,length);
+        }
+        const char_type* input = bom.second;
+        size_t input_length = length - (input - s);
+
+        basic_structural_index<char_type> index;
+        if (!index.build(input,input_length) || index.size() < 3 || input[index[0]] != '[')
+        {
+            return parse_structural(s,length);
+        }
+
+        // Index positions of the commas between the elements, and of the closing bracket
+        std::vector<size_t> commas;
+        size_t depth = 0;
+        for (size_t i = 0; i < index.size() && (i == 0 || depth > 0); ++i)
+        {
+            switch (input[index[i]])
+            {
+            case '[':
+            case '{':
+                ++depth;
+                break;
+            case ']':
+            case '}':
+                if (--depth == 0)
+                {
+                    commas.push_back(i);
+                }
+                break;
+            case ',':
+                if (depth == 1)
+                {
+                    commas.push_back(i);
+                }
+                break;
+            }
+        }
+        if (depth != 0 || commas.size() < 2 || commas.back() != index.size() - 1 || input[index[commas.back()]] != ']')
+        {
+            return parse_structural(s,length);
+        }
+
+        // Each range is [first,last) in the index
+        size_t num_ranges = (std::min)(num_threads*4, commas.size());
+        std::vector<std::pair<size_t,size_t>> ranges;
+        size_t first = 1;
+        size_t j = 0;
+        for (size_t k = 1; k < num_ranges; ++k)
+        {
+            size_t target = input_length / num_ranges * k;
+            while (j < commas.size() - 1 && index[commas[j]] < target)
+            {
+                ++j;
+            }
+            if (j == commas.size() - 1)
+            {
+                break;
+            }
+            ranges.push_back(std::make_pair(first,commas[j]));
+            first = commas[j] + 1;
+            ++j;
+        }
+        ranges.push_back(std::make_pair(first,commas.back()));
+
+        std::vector<basic_json> segments(ranges.size());
+        std::vector<std::exception_ptr> errors(ranges.size());
+        std::atomic<size_t> next(0);
+        auto task = [&]()
+        {
+            size_t k;
+            while ((k = next.fetch_add(1)) < ranges.size())
+            {
+                try
+                {
+                    json_decoder<json_type> handler;
+                    basic_json_structural_parser<char_type> parser(handler);
+                    parser.parse_array_elements(input,input_length,index,ranges[k].first,ranges[k].second);
+                    segments[k] = handler.get_result();
+                }
+                catch (...)
+                {
+                    errors[k] = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        size_t num_workers = (std::min)(num_threads,ranges.size()) - 1;
+        threads.reserve(num_workers);
+        try
+        {
+            for (size_t i = 0; i < num_workers; ++i)
+            {
+                threads.emplace_back(task);
+            }
+        }
+        catch (...)
+        {
+            // The ranges that the threads not started would have taken are
+            // parsed here by the threads that did start and the calling thread
+        }
+        task();
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        for (auto& e : errors)
+        {
+            if (e)
+            {
+                std::rethrow_exception(e);
+            }
+        }
+
+        size_t count = 0;
+        for (const auto& segment : segments)
+        {
+            count += segment.size();
+        }
+        basic_json result = std::move(segments[0]);
+        result.reserve(count);
+        for (size_t k = 1; k < segments.size(); ++k)
+        {
+            for (auto& val : segments[k].array_range())
+            {
+                result.add(std::move(val));
+            }
+        }
+        return result;
+    }
+
     friend std::basic_ostream<char_type>& operator<<(std::basic_ostream<char_type>& os, const json_type& o)
     {
         o.dump(os);
@@ -3972,6 +4946,147 @@ json_printable<Json> pretty_print(const Json& val,
     return json_printable<Json>(val, true, options);
 }
 
+// Computes the length of the compact text that dump writes, without
+// writing it. Strings are measured by escaping them into a counting_sink,
+// integers from their digit counts, and doubles by formatting them.
+
+template<class Json>
+class json_size_measure
+{
+public:
+    typedef typename Json::char_type char_type;
+    typedef typename Json::string_view_type string_view_type;
+private:
+    const basic_serialization_options<char_type>& options_;
+    print_double<char_type> fp_;
+    size_t nan_length_;
+    size_t pos_inf_length_;
+    size_t neg_inf_length_;
+public:
+    json_size_measure(const basic_serialization_options<char_type>& options)
+        : options_(options), 
+          fp_(options.precision()),
+          nan_length_(options.nan_replacement().length()),
+          pos_inf_length_(options.pos_inf_replacement().length()),
+          neg_inf_length_(options.neg_inf_replacement().length())
+    {
+    }
+
+    size_t size(const Json& val)
+    {
+        switch (val.type_id())
+        {
+        case value_type::small_string_t:
+        case value_type::string_t:
+            return string_size(val.as_string_view());
+        case value_type::double_t:
+            return double_size(val.as_double(), static_cast<uint8_t>(val.double_precision()));
+        case value_type::integer_t:
+            {
+                int64_t i = val.as_integer();
+                return i < 0 ? 1 + integer_to_decimal_digit_count(uint64_t(0) - static_cast<uint64_t>(i))
+                             : integer_to_decimal_digit_count(static_cast<uint64_t>(i));
+            }
+        case value_type::uinteger_t:
+            return integer_to_decimal_digit_count(val.as_uinteger());
+        case value_type::bool_t:
+            return val.as_bool() ? json_literals<char_type>::true_literal().second
+                                 : json_literals<char_type>::false_literal().second;
+        case value_type::null_t:
+            return json_literals<char_type>::null_literal().second;
+        case value_type::empty_object_t:
+            return 2;
+        case value_type::object_t:
+            {
+                // Braces, and a comma between members
+                const auto& o = val.object_value();
+                size_t n = o.size() > 0 ? o.size() + 1 : 2;
+                for (auto it = o.begin(); it != o.end(); ++it)
+                {
+                    // The colon after the name
+                    n += string_size(string_view_type(it->key().data(),it->key().length())) + 1;
+                    n += size(it->value());
+                }
+                return n;
+            }
+        case value_type::array_t:
+            {
+                // Brackets, and a comma between elements
+                const auto& a = val.array_value();
+                size_t n = a.size() > 0 ? a.size() + 1 : 2;
+                switch (a.packing())
+                {
+                case array_packing::doubles:
+                    for (size_t i = 0; i < a.size(); ++i)
+                    {
+                        n += double_size(a.packed_doubles()[i], a.packed_precisions()[i]);
+                    }
+                    break;
+                case array_packing::integers:
+                    for (size_t i = 0; i < a.size(); ++i)
+                    {
+                        int64_t v = a.packed_integers()[i];
+                        n += v < 0 ? 1 + integer_to_decimal_digit_count(uint64_t(0) - static_cast<uint64_t>(v))
+                                   : integer_to_decimal_digit_count(static_cast<uint64_t>(v));
+                    }
+                    break;
+                default:
+                    for (auto it = a.begin(); it != a.end(); ++it)
+                    {
+                        n += size(*it);
+                    }
+                    break;
+                }
+                return n;
+            }
+        default:
+            return 0;
+        }
+    }
+private:
+    size_t string_size(string_view_type sv)
+    {
+        size_t n = 2;
+        counting_sink<char_type> sink(n);
+        escape_string<char_type>(sv.data(), sv.length(), options_, sink);
+        return n;
+    }
+
+    size_t double_size(double val, uint8_t precision)
+    {
+        if ((std::isnan)(val))
+        {
+            return nan_length_;
+        }
+        else if (val == std::numeric_limits<double>::infinity())
+        {
+            return pos_inf_length_;
+        }
+        else if (!(std::isfinite)(val))
+        {
+            return neg_inf_length_;
+        }
+        size_t n = 0;
+        counting_sink<char_type> sink(n);
+        fp_(val, precision, sink);
+        return n;
+    }
+};
+
+template<class Json>
+size_t serialized_size(const Json& val)
+{
+    basic_serialization_options<typename Json::char_type> options;
+    return json_size_measure<Json>(options).size(val);
+}
+
+template<class Json>
+size_t serialized_size(const Json& val,
+                       const basic_serialization_options<typename Json::char_type>& options)
+{
+    return json_size_measure<Json>(options).size(val);
+}
+
 typedef basic_json<char,json_traits<char>,std::allocator<char>> json;
 typedef basic_json<wchar_t,json_traits<wchar_t>,std::allocator<wchar_t>> wjson;
 typedef basic_json<char, o_json_traits<char>, std::allocator<char>> ojson;
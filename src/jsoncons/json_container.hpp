@@ -12,13 +12,17 @@
 #include <deque>
 #include <exception>
 #include <cstdlib>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <utility>
+#include <memory>
 #include <initializer_list>
+#include <atomic>
+#include <mutex>
 #include <jsoncons/jsoncons.hpp>
 #include <jsoncons/json_traits.hpp>
 #include <jsoncons/jsoncons_util.hpp>
@@ -43,90 +47,112 @@ private:
     allocator_type self_allocator_;
 };
 
+// A long string in a single allocation, the allocator and length followed by
+// the characters and a terminating null. Strings are created and destroyed
+// with create and destroy, and are immutable.
+
 template <class Json>
 class Json_string_ 
 {
 public:
     typedef typename Json::allocator_type allocator_type;
-    typedef typename Json::char_allocator_type char_allocator_type;
     typedef typename Json::char_type char_type;
-    typedef typename Json::string_storage_type string_storage_type;
-    typedef typename string_storage_type::iterator iterator;
-    typedef typename string_storage_type::const_iterator const_iterator;
-    //using Json_string_base_<Json>::get_allocator;
-
-    Json_string_()
-        : //Json_string_base_<Json>(), 
-          string_()
-    {
-    }
-    Json_string_(const Json_string_& val)
-        : //Json_string_base_<Json>(val.get_allocator()),
-          string_(val.string_)
-    {
-    }
-    Json_string_(const Json_string_& val, const allocator_type& allocator)
-        : //Json_string_base_<Json>(allocator), 
-          string_(val.string_,char_allocator_type(allocator))
+private:
+    // Has the size and alignment of Json_string_
+    struct storage_type
     {
-    }
+        allocator_type allocator_;
+        size_t length_;
+    };
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<storage_type> storage_allocator_type;
+    typedef typename std::allocator_traits<storage_allocator_type>::pointer storage_pointer;
 
-    Json_string_(Json_string_&& val) JSONCONS_NOEXCEPT
-        : //Json_string_base_<Json>(val.get_allocator()), 
-          string_(std::move(val.string_))
-    {
-    }
-    Json_string_(Json_string_&& val, const allocator_type& allocator)
-        : //Json_string_base_<Json>(allocator), 
-          string_(std::move(val.string_),char_allocator_type(allocator))
+    allocator_type allocator_;
+    size_t length_;
+
+    Json_string_(size_t length, const allocator_type& allocator)
+        : allocator_(allocator), length_(length)
     {
     }
 
-    explicit Json_string_(const allocator_type& allocator)
-        : //Json_string_base_<Json>(allocator), 
-          string_(char_allocator_type(allocator))
+    // The number of storage_type units for a string of length characters
+    static size_t storage_count(size_t length)
     {
+        return (sizeof(Json_string_) + (length + 1)*sizeof(char_type) + sizeof(storage_type) - 1)/sizeof(storage_type);
     }
 
-    Json_string_(const char_type* data, size_t length)
-        : //Json_string_base_<Json>(), 
-        string_(data,length)
+    Json_string_(const Json_string_&) = delete;
+    Json_string_& operator=(const Json_string_&) = delete;
+public:
+    static Json_string_* create(const char_type* data, size_t length, const allocator_type& allocator)
     {
+        storage_allocator_type alloc(allocator);
+        storage_pointer storage = std::allocator_traits<storage_allocator_type>::allocate(alloc, storage_count(length));
+        Json_string_* ptr = new(to_plain_pointer(storage))Json_string_(length, allocator);
+        char_type* p = const_cast<char_type*>(ptr->data());
+        std::memcpy(p, data, length*sizeof(char_type));
+        p[length] = 0;
+        return ptr;
     }
 
-    Json_string_(const char_type* data, size_t length, allocator_type allocator)
-        : //Json_string_base_<Json>(allocator), 
-          string_(data, length, allocator)
+    static void destroy(Json_string_* ptr)
     {
+        storage_allocator_type alloc(ptr->allocator_);
+        size_t count = storage_count(ptr->length_);
+        ptr->~Json_string_();
+        std::allocator_traits<storage_allocator_type>::deallocate(alloc, 
+            std::pointer_traits<storage_pointer>::pointer_to(*reinterpret_cast<storage_type*>(ptr)), count);
     }
 
+    // The characters follow the header, sizeof(Json_string_) is a multiple of 
+    // its alignment, which is at least that of char_type
+
     const char_type* data() const
     {
-        return string_.data();
+        return reinterpret_cast<const char_type*>(this + 1);
     }
 
     const char_type* c_str() const
     {
-        return string_.c_str();
+        return data();
     }
 
     size_t length() const
     {
-        return string_.size();
+        return length_;
     }
 
     allocator_type get_allocator() const
     {
-        return string_.get_allocator();
+        return allocator_;
     }
-private:
-    string_storage_type string_;
-
-    Json_string_<Json>& operator=(const Json_string_<Json>&) = delete;
 };
 
 // json_array
 
+enum class array_packing : uint8_t
+{
+    none,
+    doubles,
+    integers
+};
+
+// Element i of a packed array as a Json value, read without building the
+// array's vector of Json values
+
+template <class Json, class Array>
+Json packed_array_element(const Array& a, size_t i)
+{
+    if (a.packing() == array_packing::doubles)
+    {
+        return Json(a.packed_doubles()[i], a.packed_precisions()[i]);
+    }
+    else
+    {
+        return Json(a.packed_integers()[i]);
+    }
+}
+
 template <class Json>
 class Json_array_base_
 {
@@ -339,266 +365,1612 @@ public:
         }
         return true;
     }
-private:
-    array_storage_type elements_;
 
+    // Arrays of this type are never packed
+
+    array_packing packing() const {return array_packing::none;}
+
+    const double* packed_doubles() const {return nullptr;}
+
+    const uint8_t* packed_precisions() const {return nullptr;}
+
+    const int64_t* packed_integers() const {return nullptr;}
+
+    template <class InputIterator, class Convert>
+    bool pack(InputIterator, InputIterator, Convert)
+    {
+        return false;
+    }
+protected:
+    array_storage_type elements_;
+private:
     json_array& operator=(const json_array<Json>&) = delete;
 };
 
-// json_object
+// packed_json_array
 
-template <class BidirectionalIt,class BinaryPredicate>
-BidirectionalIt last_wins_unique_sequence(BidirectionalIt first, BidirectionalIt last, BinaryPredicate compare)
+// json_decoder stores an array whose elements are all doubles, or all
+// integers that fit in an int64_t, in a vector of those numbers rather than a
+// vector of Json values. Access to the elements as Json values through a
+// non-const reference, or adding an element of another type, unpacks the
+// array into a vector of Json values. Access through a const reference builds
+// that vector once, under a lock, and keeps the numbers, so that const
+// access from several threads is safe, as it is for other arrays.
+
+template <class Json>
+class packed_json_array : public json_array<Json>
 {
-    
-    if (first == last)
-    {
-        return last;
-    }
+public:
+    using typename json_array<Json>::allocator_type;
+    using typename json_array<Json>::value_type;
+    using typename json_array<Json>::array_storage_type;
+    using typename json_array<Json>::iterator;
+    using typename json_array<Json>::const_iterator;
+    using json_array<Json>::get_allocator;
+
+    // Arrays with fewer elements are not packed
+    static const size_t min_packed_length = 8;
+
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<double> double_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<uint8_t> precision_allocator_type;
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<int64_t> integer_allocator_type;
+private:
+    array_packing packing_;
+    std::vector<double,double_allocator_type> doubles_;
+    std::vector<uint8_t,precision_allocator_type> precisions_;
+    std::vector<int64_t,integer_allocator_type> integers_;
+    // True when a packed array's elements_ holds its numbers as Json values
+    mutable std::atomic<bool> materialized_;
+public:
 
-    typedef typename BidirectionalIt::value_type value_type;
-    typedef typename BidirectionalIt::pointer pointer;
-    std::vector<value_type> dups;
+    packed_json_array()
+        : json_array<Json>(), 
+          packing_(array_packing::none),
+          materialized_(false)
     {
-        std::vector<pointer> v(std::distance(first,last));
-        auto p = v.begin();
-        for (auto it = first; it != last; ++it)
-        {
-            *p++ = &(*it);
-        }
-        std::sort(v.begin(), v.end(), [&](pointer a, pointer b){return compare(*a,*b)<0;});
-        auto it = v.begin();
-        auto end = v.end();
-        for (auto begin = it+1; begin != end; ++it, ++begin)
-        {
-            if (compare(*(*it),*(*begin)) == 0)
-            {
-                dups.push_back(*(*it));
-            }
-        }
     }
-    if (dups.size() == 0)
+
+    explicit packed_json_array(const allocator_type& allocator)
+        : json_array<Json>(allocator), 
+          packing_(array_packing::none),
+          doubles_(double_allocator_type(allocator)),
+          precisions_(precision_allocator_type(allocator)),
+          integers_(integer_allocator_type(allocator)),
+          materialized_(false)
     {
-        return last;
     }
-    
-    auto it = last;
-    for (auto p = first; p != last && p != it; )
+
+    explicit packed_json_array(size_t n, 
+                               const allocator_type& allocator = allocator_type())
+        : json_array<Json>(n, allocator), 
+          packing_(array_packing::none),
+          doubles_(double_allocator_type(allocator)),
+          precisions_(precision_allocator_type(allocator)),
+          integers_(integer_allocator_type(allocator)),
+          materialized_(false)
     {
-        bool no_dup = true;
-        if (dups.size() > 0)
-        {
-            for (auto q = dups.begin(); no_dup && q != dups.end();)
-            {
-                if (compare(*p,*q) == 0)
-                {
-                    dups.erase(q);
-                    no_dup = false;
-                }
-                else
-                {
-                    ++q;
-                }
-            }
-        }
-        if (!no_dup)
-        {
-            --it;
-            for (auto r = p; r != it; ++r)
-            {
-                *r = std::move(*(r+1));
-            }
-        }
-        else
-        {
-            ++p;
-        }
     }
-    
-    return it;
-}
-
-template <class KeyT, class ValueT>
-class key_value_pair
-{
-public:
-    typedef KeyT key_storage_type;
-    typedef typename KeyT::value_type char_type;
-    typedef typename KeyT::allocator_type allocator_type;
-    typedef typename ValueT::string_view_type string_view_type;
 
-    key_value_pair()
+    explicit packed_json_array(size_t n, 
+                               const Json& value, 
+                               const allocator_type& allocator = allocator_type())
+        : json_array<Json>(n, value, allocator), 
+          packing_(array_packing::none),
+          doubles_(double_allocator_type(allocator)),
+          precisions_(precision_allocator_type(allocator)),
+          integers_(integer_allocator_type(allocator)),
+          materialized_(false)
     {
     }
 
-    key_value_pair(const key_storage_type& name, const ValueT& val)
-        : key_(name), value_(val)
+    template <class InputIterator>
+    packed_json_array(InputIterator begin, InputIterator end, const allocator_type& allocator = allocator_type())
+        : json_array<Json>(begin, end, allocator), 
+          packing_(array_packing::none),
+          doubles_(double_allocator_type(allocator)),
+          precisions_(precision_allocator_type(allocator)),
+          integers_(integer_allocator_type(allocator)),
+          materialized_(false)
     {
     }
+    // Copying is a const read of val, so the elements_ of a packed val,
+    // which another thread may be building, are not copied
 
-    key_value_pair(key_storage_type&& name, ValueT&& val)
-        : key_(std::forward<key_storage_type&&>(name)), 
-          value_(std::forward<ValueT&&>(val))
+    packed_json_array(const packed_json_array& val)
+        : json_array<Json>(val.get_allocator()),
+          packing_(val.packing_),
+          doubles_(val.doubles_),
+          precisions_(val.precisions_),
+          integers_(val.integers_),
+          materialized_(false)
     {
+        if (packing_ == array_packing::none)
+        {
+            this->elements_ = val.elements_;
+        }
     }
-
-    key_value_pair(const key_value_pair& member)
-        : key_(member.key_), value_(member.value_)
+    packed_json_array(const packed_json_array& val, const allocator_type& allocator)
+        : json_array<Json>(allocator), 
+          packing_(val.packing_),
+          doubles_(val.doubles_, double_allocator_type(allocator)),
+          precisions_(val.precisions_, precision_allocator_type(allocator)),
+          integers_(val.integers_, integer_allocator_type(allocator)),
+          materialized_(false)
     {
+        if (packing_ == array_packing::none)
+        {
+            this->elements_ = val.elements_;
+        }
     }
 
-    key_value_pair(key_value_pair&& member)
-        : key_(std::move(member.key_)), value_(std::move(member.value_))
+    packed_json_array(packed_json_array&& val) JSONCONS_NOEXCEPT
+        : json_array<Json>(std::move(val)), 
+          packing_(val.packing_),
+          doubles_(std::move(val.doubles_)),
+          precisions_(std::move(val.precisions_)),
+          integers_(std::move(val.integers_)),
+          materialized_(val.materialized_.load())
     {
+        val.packing_ = array_packing::none;
+        val.materialized_ = false;
     }
-
-    template <class T>
-    key_value_pair(key_storage_type&& name, 
-                   T&& val, 
-                   const allocator_type& allocator)
-        : key_(std::forward<key_storage_type&&>(name)), value_(std::forward<T&&>(val), allocator)
+    packed_json_array(packed_json_array&& val, const allocator_type& allocator)
+        : json_array<Json>(std::move(val), allocator), 
+          packing_(val.packing_),
+          doubles_(std::move(val.doubles_), double_allocator_type(allocator)),
+          precisions_(std::move(val.precisions_), precision_allocator_type(allocator)),
+          integers_(std::move(val.integers_), integer_allocator_type(allocator)),
+          materialized_(val.materialized_.load())
     {
+        val.packing_ = array_packing::none;
+        val.materialized_ = false;
     }
 
-    string_view_type key() const
+    packed_json_array(std::initializer_list<Json> init)
+        : json_array<Json>(std::move(init)), 
+          packing_(array_packing::none),
+          materialized_(false)
     {
-        return string_view_type(key_.data(),key_.size());
     }
 
-    ValueT& value()
+    packed_json_array(std::initializer_list<Json> init, 
+                      const allocator_type& allocator)
+        : json_array<Json>(std::move(init), allocator), 
+          packing_(array_packing::none),
+          doubles_(double_allocator_type(allocator)),
+          precisions_(precision_allocator_type(allocator)),
+          integers_(integer_allocator_type(allocator)),
+          materialized_(false)
     {
-        return value_;
     }
 
-    const ValueT& value() const
+    void swap(packed_json_array<Json>& val)
     {
-        return value_;
+        json_array<Json>::swap(val);
+        std::swap(packing_, val.packing_);
+        doubles_.swap(val.doubles_);
+        precisions_.swap(val.precisions_);
+        integers_.swap(val.integers_);
+        bool materialized = materialized_;
+        materialized_ = val.materialized_.load();
+        val.materialized_ = materialized;
     }
 
-    void value(const ValueT& value)
+    size_t size() const 
     {
-        value_ = value;
+        switch (packing_)
+        {
+        case array_packing::doubles:
+            return doubles_.size();
+        case array_packing::integers:
+            return integers_.size();
+        default:
+            return this->elements_.size();
+        }
     }
 
-    void value(ValueT&& value)
+    size_t capacity() const 
     {
-        value_ = std::forward<ValueT&&>(value);
+        switch (packing_)
+        {
+        case array_packing::doubles:
+            return doubles_.capacity();
+        case array_packing::integers:
+            return integers_.capacity();
+        default:
+            return this->elements_.capacity();
+        }
     }
 
-    void swap(key_value_pair& member)
+    void clear() 
     {
-        key_.swap(member.key_);
-        value_.swap(member.value_);
+        release_packed();
+        this->elements_.clear();
     }
 
-    key_value_pair& operator=(const key_value_pair& member)
+    void shrink_to_fit() 
     {
-        if (this != & member)
+        switch (packing_)
         {
-            key_ = member.key_;
-            value_ = member.value_;
+        case array_packing::doubles:
+            doubles_.shrink_to_fit();
+            precisions_.shrink_to_fit();
+            break;
+        case array_packing::integers:
+            integers_.shrink_to_fit();
+            break;
+        default:
+            json_array<Json>::shrink_to_fit();
+            break;
         }
-        return *this;
     }
 
-    key_value_pair& operator=(key_value_pair&& member)
+    void reserve(size_t n) 
     {
-        if (this != &member)
+        switch (packing_)
         {
-            key_.swap(member.key_);
-            value_.swap(member.value_);
+        case array_packing::doubles:
+            doubles_.reserve(n);
+            precisions_.reserve(n);
+            break;
+        case array_packing::integers:
+            integers_.reserve(n);
+            break;
+        default:
+            this->elements_.reserve(n);
+            break;
         }
-        return *this;
     }
 
-    void shrink_to_fit() 
+    void resize(size_t n) 
     {
-        key_.shrink_to_fit();
-        value_.shrink_to_fit();
+        unpack();
+        this->elements_.resize(n);
     }
-#if !defined(JSONCONS_NO_DEPRECATED)
-    const key_storage_type& name() const
+
+    void resize(size_t n, const Json& val) 
     {
-        return key_;
+        unpack();
+        this->elements_.resize(n,val);
     }
-#endif
-private:
-    key_storage_type key_;
-    ValueT value_;
-};
 
-template <class KeyT,class Json>
-class Json_object_
-{
-public:
-    typedef typename Json::allocator_type allocator_type;
-    typedef typename Json::char_type char_type;
-    typedef typename Json::char_allocator_type char_allocator_type;
-    typedef KeyT key_storage_type;
-    typedef typename Json::string_view_type string_view_type;
-    typedef key_value_pair<KeyT,Json> value_type;
+    void remove_range(size_t from_index, size_t to_index) 
+    {
+        JSONCONS_ASSERT(from_index <= to_index);
+        JSONCONS_ASSERT(to_index <= size());
+        drop_materialized();
+        switch (packing_)
+        {
+        case array_packing::doubles:
+            doubles_.erase(doubles_.begin()+from_index,doubles_.begin()+to_index);
+            precisions_.erase(precisions_.begin()+from_index,precisions_.begin()+to_index);
+            break;
+        case array_packing::integers:
+            integers_.erase(integers_.begin()+from_index,integers_.begin()+to_index);
+            break;
+        default:
+            this->elements_.erase(this->elements_.begin()+from_index,this->elements_.begin()+to_index);
+            break;
+        }
+    }
 
-    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<value_type> kvp_allocator_type;
-    typedef typename Json::object_storage_type object_storage_type;
+    void erase(iterator first, iterator last) 
+    {
+        unpack();
+        this->elements_.erase(first,last);
+    }
 
-    typedef typename object_storage_type::iterator iterator;
-    typedef typename object_storage_type::const_iterator const_iterator;
+    Json& operator[](size_t i) 
+    {
+        unpack();
+        return this->elements_[i];
+    }
 
-protected:
-    allocator_type self_allocator_;
-    object_storage_type members_;
-public:
-    Json_object_()
-        : self_allocator_(), members_()
+    const Json& operator[](size_t i) const 
     {
+        materialize();
+        return this->elements_[i];
     }
-    Json_object_(const allocator_type& allocator)
-        : self_allocator_(allocator), 
-          members_(kvp_allocator_type(allocator))
+
+    template <class T>
+    void add(T&& value)
     {
+        if (!(packing_ != array_packing::none && add_packed(value)))
+        {
+            unpack();
+            json_array<Json>::add(std::forward<T&&>(value));
+        }
     }
 
-    Json_object_(const Json_object_& val)
-        : self_allocator_(val.get_allocator()), members_(val.members_)
+    // pos may come from the const begin() of a packed array, whose elements_
+    // unpack keeps
+
+    template <class T>
+    iterator add(const_iterator pos, T&& value)
     {
+        unpack();
+        return json_array<Json>::add(pos, std::forward<T&&>(value));
     }
 
-    Json_object_(Json_object_&& val)
-        : self_allocator_(val.get_allocator()), 
-          members_(std::move(val.members_))
+    iterator begin() 
     {
+        unpack();
+        return this->elements_.begin();
     }
 
-    Json_object_(const Json_object_& val, const allocator_type& allocator) :
-        self_allocator_(allocator), 
-        members_(val.members_,kvp_allocator_type(allocator))
+    iterator end() 
     {
+        unpack();
+        return this->elements_.end();
     }
 
-    Json_object_(Json_object_&& val,const allocator_type& allocator) :
-        self_allocator_(allocator), members_(std::move(val.members_),kvp_allocator_type(allocator))
+    const_iterator begin() const 
     {
+        materialize();
+        return this->elements_.begin();
     }
 
-    void swap(Json_object_& val)
+    const_iterator end() const 
     {
-        members_.swap(val.members_);
+        materialize();
+        return this->elements_.end();
     }
 
-    allocator_type get_allocator() const
+    bool operator==(const packed_json_array<Json>& rhs) const
     {
-        return this->self_allocator_;
+        if (packing_ != array_packing::none && packing_ == rhs.packing_)
+        {
+            return packing_ == array_packing::doubles ? doubles_ == rhs.doubles_ : integers_ == rhs.integers_;
+        }
+        if (size() != rhs.size())
+        {
+            return false;
+        }
+        if (packing_ == array_packing::none && rhs.packing_ == array_packing::none)
+        {
+            return json_array<Json>::operator==(rhs);
+        }
+        if (packing_ == array_packing::none)
+        {
+            return rhs == *this;
+        }
+        // Compared element by element, without building either side's elements_
+        for (size_t i = 0; i < size(); ++i)
+        {
+            bool equal = rhs.packing_ == array_packing::none 
+                ? packed_array_element<Json>(*this, i) == rhs.elements_[i]
+                : packed_array_element<Json>(*this, i) == packed_array_element<Json>(rhs, i);
+            if (!equal)
+            {
+                return false;
+            }
+        }
+        return true;
     }
-};
 
-template <class KeyT,class Json,bool PreserveOrder>
-class json_object
-{
+    array_packing packing() const {return packing_;}
+
+    const double* packed_doubles() const {return doubles_.data();}
+
+    const uint8_t* packed_precisions() const {return precisions_.data();}
+
+    const int64_t* packed_integers() const {return integers_.data();}
+
+    // Adds the values convert(*first), ..., convert(*(last-1)) to an empty
+    // array in packed form, if there are enough of them and they are all
+    // doubles or all integers that fit in an int64_t, and otherwise adds
+    // nothing and returns false
+
+    template <class InputIterator, class Convert>
+    bool pack(InputIterator first, InputIterator last, Convert convert)
+    {
+        if (size() != 0 || static_cast<size_t>(last - first) < min_packed_length)
+        {
+            return false;
+        }
+        const Json& front = convert(*first);
+        if (front.is_double())
+        {
+            for (InputIterator it = first; it != last; ++it)
+            {
+                if (!convert(*it).is_double())
+                {
+                    return false;
+                }
+            }
+            doubles_.reserve(last - first);
+            precisions_.reserve(last - first);
+            for (InputIterator it = first; it != last; ++it)
+            {
+                const Json& val = convert(*it);
+                doubles_.push_back(val.as_double());
+                precisions_.push_back(static_cast<uint8_t>(val.double_precision()));
+            }
+            packing_ = array_packing::doubles;
+            return true;
+        }
+        else if (front.is_integer())
+        {
+            for (InputIterator it = first; it != last; ++it)
+            {
+                if (!convert(*it).is_integer())
+                {
+                    return false;
+                }
+            }
+            integers_.reserve(last - first);
+            for (InputIterator it = first; it != last; ++it)
+            {
+                integers_.push_back(convert(*it).as_integer());
+            }
+            packing_ = array_packing::integers;
+            return true;
+        }
+        return false;
+    }
+
+    void unpack()
+    {
+        if (packing_ == array_packing::none)
+        {
+            return;
+        }
+        if (!materialized_.load(std::memory_order_relaxed))
+        {
+            build_elements(this->elements_);
+        }
+        release_packed();
+    }
+private:
+
+    static std::mutex& materialize_mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // Builds elements_ for const access and keeps the numbers, which other
+    // threads may be reading
+
+    void materialize() const
+    {
+        if (packing_ == array_packing::none || materialized_.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(materialize_mutex());
+        if (!materialized_.load(std::memory_order_relaxed))
+        {
+            build_elements(const_cast<array_storage_type&>(this->elements_));
+            materialized_.store(true, std::memory_order_release);
+        }
+    }
+
+    void build_elements(array_storage_type& elements) const
+    {
+        elements.reserve(size());
+        if (packing_ == array_packing::doubles)
+        {
+            for (size_t i = 0; i < doubles_.size(); ++i)
+            {
+                elements.emplace_back(Json(doubles_[i],precisions_[i]));
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < integers_.size(); ++i)
+            {
+                elements.emplace_back(Json(integers_[i]));
+            }
+        }
+    }
+
+    // Called before the numbers of a packed array change
+    void drop_materialized()
+    {
+        if (materialized_)
+        {
+            this->elements_.clear();
+            materialized_ = false;
+        }
+    }
+
+    void release_packed()
+    {
+        materialized_ = false;
+        packing_ = array_packing::none;
+        std::vector<double,double_allocator_type>(doubles_.get_allocator()).swap(doubles_);
+        std::vector<uint8_t,precision_allocator_type>(precisions_.get_allocator()).swap(precisions_);
+        std::vector<int64_t,integer_allocator_type>(integers_.get_allocator()).swap(integers_);
+    }
+
+    bool add_packed(const Json& val)
+    {
+        if (packing_ == array_packing::doubles && val.is_double())
+        {
+            drop_materialized();
+            doubles_.push_back(val.as_double());
+            precisions_.push_back(static_cast<uint8_t>(val.double_precision()));
+            return true;
+        }
+        else if (packing_ == array_packing::integers && val.is_integer())
+        {
+            drop_materialized();
+            integers_.push_back(val.as_integer());
+            return true;
+        }
+        return false;
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_floating_point<T>::value,bool>::type
+    add_packed(T val)
+    {
+        if (packing_ == array_packing::doubles)
+        {
+            drop_materialized();
+            doubles_.push_back(val);
+            precisions_.push_back(0);
+            return true;
+        }
+        return false;
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T,bool>::value,bool>::type
+    add_packed(T val)
+    {
+        if (packing_ == array_packing::integers && 
+            (std::is_signed<T>::value || static_cast<uint64_t>(val) <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)())))
+        {
+            drop_materialized();
+            integers_.push_back(static_cast<int64_t>(val));
+            return true;
+        }
+        return false;
+    }
+
+    template <class T>
+    typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_same<typename std::decay<T>::type,Json>::value,bool>::type
+    add_packed(const T&)
+    {
+        return false;
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,bool>::value,bool>::type
+    add_packed(T)
+    {
+        return false;
+    }
+
+    packed_json_array& operator=(const packed_json_array<Json>&) = delete;
+};
+
+// json_object
+
+template <class BidirectionalIt,class BinaryPredicate>
+BidirectionalIt last_wins_unique_sequence(BidirectionalIt first, BidirectionalIt last, BinaryPredicate compare)
+{
+    
+    if (first == last)
+    {
+        return last;
+    }
+
+    typedef typename BidirectionalIt::value_type value_type;
+    typedef typename BidirectionalIt::pointer pointer;
+    std::vector<value_type> dups;
+    {
+        std::vector<pointer> v(std::distance(first,last));
+        auto p = v.begin();
+        for (auto it = first; it != last; ++it)
+        {
+            *p++ = &(*it);
+        }
+        std::sort(v.begin(), v.end(), [&](pointer a, pointer b){return compare(*a,*b)<0;});
+        auto it = v.begin();
+        auto end = v.end();
+        for (auto begin = it+1; begin != end; ++it, ++begin)
+        {
+            if (compare(*(*it),*(*begin)) == 0)
+            {
+                dups.push_back(*(*it));
+            }
+        }
+    }
+    if (dups.size() == 0)
+    {
+        return last;
+    }
+    
+    auto it = last;
+    for (auto p = first; p != last && p != it; )
+    {
+        bool no_dup = true;
+        if (dups.size() > 0)
+        {
+            for (auto q = dups.begin(); no_dup && q != dups.end();)
+            {
+                if (compare(*p,*q) == 0)
+                {
+                    dups.erase(q);
+                    no_dup = false;
+                }
+                else
+                {
+                    ++q;
+                }
+            }
+        }
+        if (!no_dup)
+        {
+            --it;
+            for (auto r = p; r != it; ++r)
+            {
+                *r = std::move(*(r+1));
+            }
+        }
+        else
+        {
+            ++p;
+        }
+    }
+    
+    return it;
+}
+
+template <class KeyT, class ValueT>
+class key_value_pair
+{
+public:
+    typedef KeyT key_storage_type;
+    typedef typename KeyT::value_type char_type;
+    typedef typename KeyT::allocator_type allocator_type;
+    typedef typename ValueT::string_view_type string_view_type;
+
+    key_value_pair()
+    {
+    }
+
+    key_value_pair(const key_storage_type& name, const ValueT& val)
+        : key_(name), value_(val)
+    {
+    }
+
+    key_value_pair(key_storage_type&& name, ValueT&& val)
+        : key_(std::forward<key_storage_type&&>(name)), 
+          value_(std::forward<ValueT&&>(val))
+    {
+    }
+
+    key_value_pair(const key_value_pair& member)
+        : key_(member.key_), value_(member.value_)
+    {
+    }
+
+    key_value_pair(key_value_pair&& member)
+        : key_(std::move(member.key_)), value_(std::move(member.value_))
+    {
+    }
+
+    template <class T>
+    key_value_pair(key_storage_type&& name, 
+                   T&& val, 
+                   const allocator_type& allocator)
+        : key_(std::forward<key_storage_type&&>(name)), value_(std::forward<T&&>(val), allocator)
+    {
+    }
+
+    string_view_type key() const
+    {
+        return string_view_type(key_.data(),key_.size());
+    }
+
+    // Keys that share their characters with name, such as interned keys
+    // made by the same decoder, are equal without comparing characters
+
+    bool key_equals(string_view_type name) const
+    {
+        return (key_.data() == name.data() && key_.size() == name.size()) || key() == name;
+    }
+
+    ValueT& value()
+    {
+        return value_;
+    }
+
+    const ValueT& value() const
+    {
+        return value_;
+    }
+
+    void value(const ValueT& value)
+    {
+        value_ = value;
+    }
+
+    void value(ValueT&& value)
+    {
+        value_ = std::forward<ValueT&&>(value);
+    }
+
+    void swap(key_value_pair& member)
+    {
+        key_.swap(member.key_);
+        value_.swap(member.value_);
+    }
+
+    key_value_pair& operator=(const key_value_pair& member)
+    {
+        if (this != & member)
+        {
+            key_ = member.key_;
+            value_ = member.value_;
+        }
+        return *this;
+    }
+
+    key_value_pair& operator=(key_value_pair&& member)
+    {
+        if (this != &member)
+        {
+            key_.swap(member.key_);
+            value_.swap(member.value_);
+        }
+        return *this;
+    }
+
+    void shrink_to_fit() 
+    {
+        key_.shrink_to_fit();
+        value_.shrink_to_fit();
+    }
+#if !defined(JSONCONS_NO_DEPRECATED)
+    const key_storage_type& name() const
+    {
+        return key_;
+    }
+#endif
+private:
+    key_storage_type key_;
+    ValueT value_;
+};
+
+// object_index
+
+// An open addressing table of the positions of an object's members, with a
+// control byte for each slot that is empty, deleted, or holds 7 bits of the
+// hash of the member's name. Probes compare control bytes, and look at a
+// member only when its hash bits match. Members is a random access sequence
+// of key_value_pair, and every function that takes it must be given the
+// current members.
+
+template <class Allocator>
+class object_index
+{
+    static const uint8_t empty_slot = 0x80;
+    static const uint8_t deleted_slot = 0xFE;
+    static const size_t min_capacity = 16;
+
+    typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<uint8_t> control_allocator_type;
+    typedef typename std::allocator_traits<Allocator>:: template rebind_alloc<uint32_t> position_allocator_type;
+
+    std::vector<uint8_t,control_allocator_type> control_;
+    std::vector<uint32_t,position_allocator_type> positions_;
+    size_t size_;
+    size_t deleted_;
+
+    template <class StringView>
+    static size_t hash(const StringView& name)
+    {
+        return hash_string(name.data(), name.length());
+    }
+
+    static uint8_t control_bits(size_t h)
+    {
+        return static_cast<uint8_t>(h & 0x7F);
+    }
+
+    // The slot of the member at pos, which must be in the table
+    template <class Members>
+    size_t slot_of(const Members& members, size_t pos) const
+    {
+        size_t mask = control_.size() - 1;
+        size_t i = (hash(members[pos].key()) >> 7) & mask;
+        while ((control_[i] & empty_slot) != 0 || positions_[i] != pos)
+        {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    template <class Members>
+    void add(const Members& members, size_t pos)
+    {
+        size_t h = hash(members[pos].key());
+        size_t mask = control_.size() - 1;
+        size_t i = (h >> 7) & mask;
+        while ((control_[i] & empty_slot) == 0)
+        {
+            i = (i + 1) & mask;
+        }
+        if (control_[i] == deleted_slot)
+        {
+            --deleted_;
+        }
+        control_[i] = control_bits(h);
+        positions_[i] = static_cast<uint32_t>(pos);
+        ++size_;
+    }
+public:
+    object_index()
+        : size_(0), deleted_(0)
+    {
+    }
+
+    explicit object_index(const Allocator& allocator)
+        : control_(control_allocator_type(allocator)), 
+          positions_(position_allocator_type(allocator)), 
+          size_(0), deleted_(0)
+    {
+    }
+
+    object_index(const object_index& other, const Allocator& allocator)
+        : control_(other.control_, control_allocator_type(allocator)), 
+          positions_(other.positions_, position_allocator_type(allocator)), 
+          size_(other.size_), deleted_(other.deleted_)
+    {
+    }
+
+    object_index(object_index&& other, const Allocator& allocator)
+        : control_(std::move(other.control_), control_allocator_type(allocator)), 
+          positions_(std::move(other.positions_), position_allocator_type(allocator)), 
+          size_(other.size_), deleted_(other.deleted_)
+    {
+        other.clear();
+    }
+
+    object_index(const object_index& other) = default;
+
+    object_index(object_index&& other)
+        : control_(std::move(other.control_)), 
+          positions_(std::move(other.positions_)), 
+          size_(other.size_), deleted_(other.deleted_)
+    {
+        other.clear();
+    }
+
+    // True if there is no table
+    bool empty() const
+    {
+        return control_.empty();
+    }
+
+    void clear()
+    {
+        control_.clear();
+        positions_.clear();
+        size_ = 0;
+        deleted_ = 0;
+    }
+
+    void swap(object_index& other)
+    {
+        control_.swap(other.control_);
+        positions_.swap(other.positions_);
+        std::swap(size_, other.size_);
+        std::swap(deleted_, other.deleted_);
+    }
+
+    // Returns members.size() if there is no member with this name
+
+    template <class Members, class StringView>
+    size_t find(const Members& members, const StringView& name) const
+    {
+        size_t h = hash(name);
+        uint8_t bits = control_bits(h);
+        size_t mask = control_.size() - 1;
+        for (size_t i = (h >> 7) & mask; control_[i] != empty_slot; i = (i + 1) & mask)
+        {
+            if (control_[i] == bits && members[positions_[i]].key_equals(name))
+            {
+                return positions_[i];
+            }
+        }
+        return members.size();
+    }
+
+    // Adds the last member, which must not have the name of another member
+
+    template <class Members>
+    void push_back(const Members& members)
+    {
+        if (4*(size_ + deleted_ + 1) > 3*control_.size())
+        {
+            rebuild(members);
+        }
+        else
+        {
+            add(members, members.size() - 1);
+        }
+    }
+
+    // Removes the member at pos
+
+    template <class Members>
+    void erase(const Members& members, size_t pos)
+    {
+        control_[slot_of(members, pos)] = deleted_slot;
+        --size_;
+        ++deleted_;
+    }
+
+    // The member at from is about to be moved to to
+
+    template <class Members>
+    void relocate(const Members& members, size_t from, size_t to)
+    {
+        positions_[slot_of(members, from)] = static_cast<uint32_t>(to);
+    }
+
+    template <class Members>
+    void rebuild(const Members& members)
+    {
+        size_t capacity = min_capacity;
+        while (capacity < 2*(members.size() + 1))
+        {
+            capacity *= 2;
+        }
+        control_.assign(capacity, static_cast<uint8_t>(empty_slot));
+        positions_.assign(capacity, 0);
+        size_ = 0;
+        deleted_ = 0;
+        for (size_t pos = 0; pos < members.size(); ++pos)
+        {
+            add(members, pos);
+        }
+    }
+};
+
+template <class KeyT,class Json>
+class Json_object_
+{
+public:
+    typedef typename Json::allocator_type allocator_type;
+    typedef typename Json::char_type char_type;
+    typedef typename Json::char_allocator_type char_allocator_type;
+    typedef KeyT key_storage_type;
+    typedef typename Json::string_view_type string_view_type;
+    typedef key_value_pair<KeyT,Json> value_type;
+
+    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<value_type> kvp_allocator_type;
+    typedef typename Json::object_storage_type object_storage_type;
+
+    typedef typename object_storage_type::iterator iterator;
+    typedef typename object_storage_type::const_iterator const_iterator;
+
+protected:
+    allocator_type self_allocator_;
+    object_storage_type members_;
+public:
+    Json_object_()
+        : self_allocator_(), members_()
+    {
+    }
+    Json_object_(const allocator_type& allocator)
+        : self_allocator_(allocator), 
+          members_(kvp_allocator_type(allocator))
+    {
+    }
+
+    Json_object_(const Json_object_& val)
+        : self_allocator_(val.get_allocator()), members_(val.members_)
+    {
+    }
+
+    Json_object_(Json_object_&& val)
+        : self_allocator_(val.get_allocator()), 
+          members_(std::move(val.members_))
+    {
+    }
+
+    Json_object_(const Json_object_& val, const allocator_type& allocator) :
+        self_allocator_(allocator), 
+        members_(val.members_,kvp_allocator_type(allocator))
+    {
+    }
+
+    Json_object_(Json_object_&& val,const allocator_type& allocator) :
+        self_allocator_(allocator), members_(std::move(val.members_),kvp_allocator_type(allocator))
+    {
+    }
+
+    void swap(Json_object_& val)
+    {
+        members_.swap(val.members_);
+    }
+
+    allocator_type get_allocator() const
+    {
+        return this->self_allocator_;
+    }
+};
+
+template <class KeyT,class Json,bool PreserveOrder>
+class json_object
+{
+};
+
+// Do not preserve order
+template <class KeyT,class Json>
+class json_object<KeyT,Json,false> : public Json_object_<KeyT,Json>
+{
+public:
+    using typename Json_object_<KeyT,Json>::allocator_type;
+    using typename Json_object_<KeyT,Json>::char_type;
+    using typename Json_object_<KeyT,Json>::char_allocator_type;
+    using typename Json_object_<KeyT,Json>::key_storage_type;
+    using typename Json_object_<KeyT,Json>::string_view_type;
+    using typename Json_object_<KeyT,Json>::value_type;
+    using typename Json_object_<KeyT,Json>::kvp_allocator_type;
+    using typename Json_object_<KeyT,Json>::object_storage_type;
+    using typename Json_object_<KeyT,Json>::iterator;
+    using typename Json_object_<KeyT,Json>::const_iterator;
+    using Json_object_<KeyT,Json>::get_allocator;
+
+    json_object()
+        : Json_object_<KeyT,Json>()
+    {
+    }
+    json_object(const allocator_type& allocator)
+        : Json_object_<KeyT,Json>(allocator)
+    {
+    }
+
+    json_object(const json_object& val)
+        : Json_object_<KeyT,Json>(val)
+    {
+    }
+
+    json_object(json_object&& val)
+        : Json_object_<KeyT,Json>(std::forward<json_object&&>(val))
+    {
+    }
+
+    json_object(const json_object& val, const allocator_type& allocator) 
+        : Json_object_<KeyT,Json>(val,allocator)
+    {
+    }
+
+    json_object(json_object&& val,const allocator_type& allocator)
+        : Json_object_<KeyT,Json>(std::forward<json_object&&>(val),allocator)
+    {
+    }
+
+    json_object(std::initializer_list<typename Json::array> init)
+        : Json_object_<KeyT,Json>()
+    {
+        for (const auto& element : init)
+        {
+            if (element.size() != 2 || !element[0].is_string())
+            {
+                JSONCONS_THROW_EXCEPTION(std::runtime_error, "Cannot create object from initializer list");
+                break;
+            }
+        }
+        for (auto& element : init)
+        {
+            set(element[0].as_string_view(), std::move(element[1]));
+        }
+    }
+
+    json_object(std::initializer_list<typename Json::array> init, 
+                const allocator_type& allocator)
+        : Json_object_<KeyT,Json>(allocator)
+    {
+        for (const auto& element : init)
+        {
+            if (element.size() != 2 || !element[0].is_string())
+            {
+                JSONCONS_THROW_EXCEPTION(std::runtime_error, "Cannot create object from initializer list");
+                break;
+            }
+        }
+        for (auto& element : init)
+        {
+            set(element[0].as_string_view(), std::move(element[1]));
+        }
+    }
+
+    void swap(json_object& val)
+    {
+        Json_object_<KeyT,Json>::swap(val);
+    }
+
+    iterator begin()
+    {
+        return this->members_.begin();
+    }
+
+    iterator end()
+    {
+        return this->members_.end();
+    }
+
+    const_iterator begin() const
+    {
+        return this->members_.begin();
+    }
+
+    const_iterator end() const
+    {
+        return this->members_.end();
+    }
+
+    size_t size() const {return this->members_.size();}
+
+    size_t capacity() const {return this->members_.capacity();}
+
+    void clear() {this->members_.clear();}
+
+    void shrink_to_fit() 
+    {
+        for (size_t i = 0; i < this->members_.size(); ++i)
+        {
+            this->members_[i].shrink_to_fit();
+        }
+        this->members_.shrink_to_fit();
+    }
+
+    void reserve(size_t n) {this->members_.reserve(n);}
+
+    Json& at(size_t i) 
+    {
+        if (i >= this->members_.size())
+        {
+            JSONCONS_THROW_EXCEPTION(std::out_of_range,"Invalid array subscript");
+        }
+        return this->members_[i].value();
+    }
+
+    const Json& at(size_t i) const 
+    {
+        if (i >= this->members_.size())
+        {
+            JSONCONS_THROW_EXCEPTION(std::out_of_range,"Invalid array subscript");
+        }
+        return this->members_[i].value();
+    }
+
+    iterator find(string_view_type name)
+    {
+        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
+                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        auto result = (it != this->members_.end() && it->key_equals(name)) ? it : this->members_.end();
+        return result;
+    }
+
+    const_iterator find(string_view_type name) const
+    {
+        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), 
+                                   name, 
+                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});
+        auto result = (it != this->members_.end() && it->key_equals(name)) ? it : this->members_.end();
+        return result;
+    }
+
+    void erase(iterator first, iterator last) 
+    {
+        this->members_.erase(first,last);
+    }
+
+    void erase(string_view_type name) 
+    {
+        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
+                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        if (it != this->members_.end() && it->key() == name)
+        {
+            this->members_.erase(it);
+        }
+    }
+
+    // Of the members with the same name, the last one inserted is kept.
+    // Members that arrive in order, as they do when an object that was
+    // serialized by jsoncons is parsed, are not sorted again.
+
+    template<class InputIt, class UnaryPredicate>
+    void insert(InputIt first, InputIt last, UnaryPredicate pred)
+    {
+        size_t count = std::distance(first,last);
+        this->members_.reserve(this->members_.size() + count);
+        size_t descents = 0;
+        bool duplicates = false;
+        for (auto s = first; s != last; ++s)
+        {
+            this->members_.emplace_back(pred(*s));
+            size_t size = this->members_.size();
+            if (size > 1)
+            {
+                int result = this->members_[size-2].key().compare(this->members_[size-1].key());
+                if (result > 0)
+                {
+                    ++descents;
+                }
+                duplicates = duplicates || result == 0;
+            }
+        }
+        if (descents > 0)
+        {
+            // A few members out of place are moved into place one at a time
+            if (descents*16 > this->members_.size() || !insertion_sort_members())
+            {
+                sort_members();
+            }
+            duplicates = true;
+        }
+        if (duplicates)
+        {
+            remove_duplicates();
+        }
+    }
+
+    template <class T, class U=allocator_type,
+        typename std::enable_if<is_stateless<U>::value
+           >::type* = nullptr>
+    void set(string_view_type name, T&& value)
+    {
+        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
+                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        if (it == this->members_.end())
+        {
+            this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
+                                  std::forward<T&&>(value));
+        }
+        else if (it->key() == name)
+        {
+            it->value(Json(std::forward<T&&>(value)));
+        }
+        else
+        {
+            this->members_.emplace(it,
+                             key_storage_type(name.begin(),name.end()),
+                             std::forward<T&&>(value));
+        }
+    }
+
+    template <class T, class U=allocator_type,
+        typename std::enable_if<!is_stateless<U>::value
+           >::type* = nullptr>
+    void set(string_view_type name, T&& value)
+    {
+        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
+                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        if (it == this->members_.end())
+        {
+            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()),
+                                  std::forward<T&&>(value),get_allocator() );
+        }
+        else if (it->key() == name)
+        {
+            it->value(Json(std::forward<T&&>(value),get_allocator() ));
+        }
+        else
+        {
+            this->members_.emplace(it,
+                             key_storage_type(name.begin(),name.end(), get_allocator()),
+                             std::forward<T&&>(value),get_allocator() );
+        }
+    }
+
+    template <class T, class U=allocator_type,
+        typename std::enable_if<is_stateless<U>::value
+           >::type* = nullptr>
+    void set_(key_storage_type&& name, T&& value)
+    {
+        string_view_type s(name.data(), name.size());
+        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), s, 
+                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        if (it == this->members_.end())
+        {
+            this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
+                                  std::forward<T&&>(value));
+        }
+        else if (string_view_type(it->key().data(),it->key().length()) == s)
+        {
+            it->value(Json(std::forward<T&&>(value)));
+        }
+        else
+        {
+            this->members_.emplace(it,
+                             std::forward<key_storage_type&&>(name),
+                             std::forward<T&&>(value));
+        }
+    }
+
+    template <class T, class U=allocator_type,
+        typename std::enable_if<!is_stateless<U>::value
+           >::type* = nullptr>
+    void set_(key_storage_type&& name, T&& value)
+    {
+        string_view_type s(name.data(), name.size());
+        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), s,
+                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        if (it == this->members_.end())
+        {
+            this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
+                                  std::forward<T&&>(value),get_allocator() );
+        }
+        else if (string_view_type(it->key().data(), it->key().length()) == s)
+        {
+            it->value(Json(std::forward<T&&>(value),get_allocator() ));
+        }
+        else
+        {
+            this->members_.emplace(it,
+                             std::forward<key_storage_type&&>(name),
+                             std::forward<T&&>(value),get_allocator() );
+        }
+    }
+
+    template <class T, class U=allocator_type>
+        typename std::enable_if<is_stateless<U>::value,iterator>::type 
+    set(iterator hint, string_view_type name, T&& value)
+    {
+        iterator it;
+        if (hint != this->members_.end() && hint->key() <= name)
+        {
+            it = std::lower_bound(hint,this->members_.end(), name, 
+                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        }
+        else
+        {
+            it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
+                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        }
+
+        if (it == this->members_.end())
+        {
+            this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
+                                  std::forward<T&&>(value));
+            it = this->members_.begin() + (this->members_.size() - 1);
+        }
+        else if (it->key() == name)
+        {
+            it->value(Json(std::forward<T&&>(value)));
+        }
+        else
+        {
+            it = this->members_.emplace(it,
+                                  key_storage_type(name.begin(),name.end()),
+                                  std::forward<T&&>(value));
+        }
+        return it;
+    }
+
+    template <class T, class U=allocator_type>
+        typename std::enable_if<!is_stateless<U>::value,iterator>::type 
+    set(iterator hint, string_view_type name, T&& value)
+    {
+        iterator it;
+        if (hint != this->members_.end() && hint->key() <= name)
+        {
+            it = std::lower_bound(hint,this->members_.end(), name, 
+                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        }
+        else
+        {
+            it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
+                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        }
+
+        if (it == this->members_.end())
+        {
+            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
+                                  std::forward<T&&>(value),get_allocator() );
+            it = this->members_.begin() + (this->members_.size() - 1);
+        }
+        else if (it->key() == name)
+        {
+            it->value(Json(std::forward<T&&>(value),get_allocator() ));
+        }
+        else
+        {
+            it = this->members_.emplace(it,
+                                  key_storage_type(name.begin(),name.end(), get_allocator()),
+                                  std::forward<T&&>(value),get_allocator() );
+        }
+        return it;
+    }
+
+    template <class T, class U=allocator_type>
+        typename std::enable_if<is_stateless<U>::value,iterator>::type 
+    set_(iterator hint, key_storage_type&& name, T&& value)
+    {
+        string_view_type s(name.data(), name.size());
+        iterator it;
+        if (hint != this->members_.end() && hint->key() <= s)
+        {
+            it = std::lower_bound(hint,this->members_.end(), s, 
+                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        }
+        else
+        {
+            it = std::lower_bound(this->members_.begin(),this->members_.end(), s, 
+                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        }
+
+        if (it == this->members_.end())
+        {
+            this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
+                                  std::forward<T&&>(value));
+            it = this->members_.begin() + (this->members_.size() - 1);
+        }
+        else if (string_view_type(it->key().data(), it->key().length()) == s)
+        {
+            it->value(Json(std::forward<T&&>(value)));
+        }
+        else
+        {
+            it = this->members_.emplace(it,
+                                  std::forward<key_storage_type&&>(name),
+                                  std::forward<T&&>(value));
+        }
+        return it;
+    }
+
+    template <class T, class U=allocator_type>
+        typename std::enable_if<!is_stateless<U>::value,iterator>::type 
+    set_(iterator hint, key_storage_type&& name, T&& value)
+    {
+        string_view_type s(name.data(), name.size());
+        iterator it;
+        if (hint != this->members_.end() && hint->key() <= s)
+        {
+            it = std::lower_bound(hint,this->members_.end(), s, 
+                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        }
+        else
+        {
+            it = std::lower_bound(this->members_.begin(),this->members_.end(), s, 
+                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        }
+
+        if (it == this->members_.end())
+        {
+            this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
+                                  std::forward<T&&>(value),get_allocator() );
+            it = this->members_.begin() + (this->members_.size() - 1);
+        }
+        else if (string_view_type(it->key().data(), it->key().length()) == s)
+        {
+            it->value(Json(std::forward<T&&>(value),get_allocator() ));
+        }
+        else
+        {
+            it = this->members_.emplace(it,
+                                  std::forward<key_storage_type&&>(name),
+                                  std::forward<T&&>(value),get_allocator() );
+        }
+        return it;
+    }
+
+    bool operator==(const json_object& rhs) const
+    {
+        if (size() != rhs.size())
+        {
+            return false;
+        }
+        for (auto it = this->members_.begin(); it != this->members_.end(); ++it)
+        {
+
+            auto rhs_it = std::lower_bound(rhs.begin(), rhs.end(), *it, 
+                                           [](const value_type& a, const value_type& b){return a.key().compare(b.key()) < 0;});
+            if (rhs_it == rhs.end() || !rhs_it->key_equals(it->key()) || rhs_it->value() != it->value())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+private:
+    json_object& operator=(const json_object&) = delete;
+
+    // Sorts the members by name with a stable insertion sort, unless that
+    // would move more members than there are, in which case it gives up and
+    // returns false
+
+    bool insertion_sort_members()
+    {
+        size_t count = this->members_.size();
+        size_t moves = 0;
+        for (size_t i = 1; i < count; ++i)
+        {
+            if (this->members_[i-1].key().compare(this->members_[i].key()) > 0)
+            {
+                value_type temp(std::move(this->members_[i]));
+                size_t j = i;
+                do
+                {
+                    this->members_[j] = std::move(this->members_[j-1]);
+                    --j;
+                    ++moves;
+                } while (j > 0 && this->members_[j-1].key().compare(temp.key()) > 0);
+                this->members_[j] = std::move(temp);
+                if (moves > count)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Sorts the members by name, members with the same name staying in the
+    // order they were added. The positions are sorted rather than the members,
+    // which are then moved once each, following the cycles of the permutation.
+
+    void sort_members()
+    {
+        size_t count = this->members_.size();
+        std::vector<uint32_t> order(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            order[i] = static_cast<uint32_t>(i);
+        }
+        const object_storage_type& members = this->members_;
+        std::sort(order.begin(), order.end(),
+                  [&members](uint32_t a, uint32_t b)
+                  {
+                      int result = members[a].key().compare(members[b].key());
+                      return result < 0 || (result == 0 && a < b);
+                  });
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (order[i] != i)
+            {
+                value_type temp(std::move(this->members_[i]));
+                size_t j = i;
+                while (order[j] != i)
+                {
+                    size_t next = order[j];
+                    this->members_[j] = std::move(this->members_[next]);
+                    order[j] = static_cast<uint32_t>(j);
+                    j = next;
+                }
+                this->members_[j] = std::move(temp);
+                order[j] = static_cast<uint32_t>(j);
+            }
+        }
+    }
+
+    // Removes all but the last of each run of members with the same name
+
+    void remove_duplicates()
+    {
+        size_t count = this->members_.size();
+        size_t last = 0;
+        for (size_t pos = 1; pos < count; ++pos)
+        {
+            if (!this->members_[last].key_equals(this->members_[pos].key()))
+            {
+                ++last;
+            }
+            if (last != pos)
+            {
+                this->members_[last] = std::move(this->members_[pos]);
+            }
+        }
+        if (count > 0)
+        {
+            this->members_.erase(this->members_.begin() + (last + 1), this->members_.end());
+        }
+    }
 };
 
-// Do not preserve order
+// Preserve order
 template <class KeyT,class Json>
-class json_object<KeyT,Json,false> : public Json_object_<KeyT,Json>
+class json_object<KeyT,Json,true> : public Json_object_<KeyT,Json>
 {
 public:
     using typename Json_object_<KeyT,Json>::allocator_type;
@@ -613,32 +1985,41 @@ public:
     using typename Json_object_<KeyT,Json>::const_iterator;
     using Json_object_<KeyT,Json>::get_allocator;
 
+    // Objects with at least this many members have a hash index
+    static const size_t index_threshold = 32;
+private:
+    // Kept in step with the members by every function that changes them, so
+    // that lookups in a const object only read it
+    object_index<allocator_type> index_;
+public:
+
     json_object()
         : Json_object_<KeyT,Json>()
     {
     }
     json_object(const allocator_type& allocator)
-        : Json_object_<KeyT,Json>(allocator)
+        : Json_object_<KeyT,Json>(allocator), index_(allocator)
     {
     }
 
     json_object(const json_object& val)
-        : Json_object_<KeyT,Json>(val)
+        : Json_object_<KeyT,Json>(val), index_(val.index_)
     {
     }
 
     json_object(json_object&& val)
-        : Json_object_<KeyT,Json>(std::forward<json_object&&>(val))
+        : Json_object_<KeyT,Json>(std::forward<json_object&&>(val)), index_(std::move(val.index_))
     {
     }
 
     json_object(const json_object& val, const allocator_type& allocator) 
-        : Json_object_<KeyT,Json>(val,allocator)
+        : Json_object_<KeyT,Json>(val,allocator), index_(val.index_,allocator)
     {
     }
 
-    json_object(json_object&& val,const allocator_type& allocator)
-        : Json_object_<KeyT,Json>(std::forward<json_object&&>(val),allocator)
+    json_object(json_object&& val,const allocator_type& allocator) 
+        : Json_object_<KeyT,Json>(std::forward<json_object&&>(val),allocator), 
+          index_(std::move(val.index_),allocator)
     {
     }
 
@@ -680,6 +2061,7 @@ public:
     void swap(json_object& val)
     {
         Json_object_<KeyT,Json>::swap(val);
+        index_.swap(val.index_);
     }
 
     iterator begin()
@@ -706,7 +2088,11 @@ public:
 
     size_t capacity() const {return this->members_.capacity();}
 
-    void clear() {this->members_.clear();}
+    void clear() 
+    {
+        this->members_.clear();
+        index_.clear();
+    }
 
     void shrink_to_fit() 
     {
@@ -739,33 +2125,27 @@ public:
 
     iterator find(string_view_type name)
     {
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        auto result = (it != this->members_.end() && it->key() == name) ? it : this->members_.end();
-        return result;
+        return this->members_.begin() + find_position(name);
     }
 
     const_iterator find(string_view_type name) const
     {
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), 
-                                   name, 
-                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});
-        auto result = (it != this->members_.end() && it->key() == name) ? it : this->members_.end();
-        return result;
+        return this->members_.begin() + find_position(name);
     }
 
     void erase(iterator first, iterator last) 
     {
         this->members_.erase(first,last);
+        rebuild_index();
     }
 
     void erase(string_view_type name) 
     {
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        if (it != this->members_.end() && it->key() == name)
+        size_t pos = find_position(name);
+        if (pos != this->members_.size())
         {
-            this->members_.erase(it);
+            this->members_.erase(this->members_.begin() + pos);
+            rebuild_index();
         }
     }
 
@@ -778,11 +2158,16 @@ public:
         {
             this->members_.emplace_back(pred(*s));
         }
-        std::stable_sort(this->members_.begin(),this->members_.end(),
-                         [](const value_type& a, const value_type& b){return a.key().compare(b.key()) < 0;});
-        auto it = std::unique(this->members_.rbegin(), this->members_.rend(),
-                              [](const value_type& a, const value_type& b){ return !(a.key().compare(b.key()));});
-        this->members_.erase(this->members_.begin(),it.base());
+        if (this->members_.size() < index_threshold)
+        {
+            auto it = last_wins_unique_sequence(this->members_.begin(), this->members_.end(),
+                                  [](const value_type& a, const value_type& b){ return a.key().compare(b.key());});
+            this->members_.erase(it,this->members_.end());
+        }
+        else
+        {
+            remove_duplicates();
+        }
     }
 
     template <class T, class U=allocator_type,
@@ -790,22 +2175,17 @@ public:
            >::type* = nullptr>
     void set(string_view_type name, T&& value)
     {
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        auto it = find(name);
+
         if (it == this->members_.end())
         {
             this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
                                   std::forward<T&&>(value));
-        }
-        else if (it->key() == name)
-        {
-            it->value(Json(std::forward<T&&>(value)));
+            index_back();
         }
         else
         {
-            this->members_.emplace(it,
-                             key_storage_type(name.begin(),name.end()),
-                             std::forward<T&&>(value));
+            it->value(Json(std::forward<T&&>(value)));
         }
     }
 
@@ -814,22 +2194,17 @@ public:
            >::type* = nullptr>
     void set(string_view_type name, T&& value)
     {
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        auto it = find(name);
+
         if (it == this->members_.end())
         {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()),
-                                  std::forward<T&&>(value),get_allocator() );
-        }
-        else if (it->key() == name)
-        {
-            it->value(Json(std::forward<T&&>(value),get_allocator() ));
+            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
+                                  std::forward<T&&>(value),get_allocator());
+            index_back();
         }
         else
         {
-            this->members_.emplace(it,
-                             key_storage_type(name.begin(),name.end(), get_allocator()),
-                             std::forward<T&&>(value),get_allocator() );
+            it->value(Json(std::forward<T&&>(value),get_allocator()));
         }
     }
 
@@ -838,23 +2213,17 @@ public:
            >::type* = nullptr>
     void set_(key_storage_type&& name, T&& value)
     {
-        string_view_type s(name.data(), name.size());
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), s, 
-                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        auto it = find(string_view_type(name.data(),name.size()));
+
         if (it == this->members_.end())
         {
             this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
                                   std::forward<T&&>(value));
-        }
-        else if (string_view_type(it->key().data(),it->key().length()) == s)
-        {
-            it->value(Json(std::forward<T&&>(value)));
+            index_back();
         }
         else
         {
-            this->members_.emplace(it,
-                             std::forward<key_storage_type&&>(name),
-                             std::forward<T&&>(value));
+            it->value(Json(std::forward<T&&>(value)));
         }
     }
 
@@ -863,23 +2232,17 @@ public:
            >::type* = nullptr>
     void set_(key_storage_type&& name, T&& value)
     {
-        string_view_type s(name.data(), name.size());
-        auto it = std::lower_bound(this->members_.begin(),this->members_.end(), s,
-                                   [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
+        auto it = find(string_view_type(name.data(),name.size()));
+
         if (it == this->members_.end())
         {
             this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
-                                  std::forward<T&&>(value),get_allocator() );
-        }
-        else if (string_view_type(it->key().data(), it->key().length()) == s)
-        {
-            it->value(Json(std::forward<T&&>(value),get_allocator() ));
+                                  std::forward<T&&>(value),get_allocator());
+            index_back();
         }
         else
         {
-            this->members_.emplace(it,
-                             std::forward<key_storage_type&&>(name),
-                             std::forward<T&&>(value),get_allocator() );
+            it->value(Json(std::forward<T&&>(value),get_allocator()));
         }
     }
 
@@ -887,23 +2250,14 @@ public:
         typename std::enable_if<is_stateless<U>::value,iterator>::type 
     set(iterator hint, string_view_type name, T&& value)
     {
-        iterator it;
-        if (hint != this->members_.end() && hint->key() <= name)
-        {
-            it = std::lower_bound(hint,this->members_.end(), name, 
-                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        }
-        else
-        {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        }
+        iterator it = hint;
 
         if (it == this->members_.end())
         {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
+            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
                                   std::forward<T&&>(value));
             it = this->members_.begin() + (this->members_.size() - 1);
+            index_back();
         }
         else if (it->key() == name)
         {
@@ -914,6 +2268,7 @@ public:
             it = this->members_.emplace(it,
                                   key_storage_type(name.begin(),name.end()),
                                   std::forward<T&&>(value));
+            rebuild_index();
         }
         return it;
     }
@@ -922,61 +2277,43 @@ public:
         typename std::enable_if<!is_stateless<U>::value,iterator>::type 
     set(iterator hint, string_view_type name, T&& value)
     {
-        iterator it;
-        if (hint != this->members_.end() && hint->key() <= name)
-        {
-            it = std::lower_bound(hint,this->members_.end(), name, 
-                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        }
-        else
-        {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), name, 
-                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        }
+        iterator it = hint;
 
         if (it == this->members_.end())
         {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
-                                  std::forward<T&&>(value),get_allocator() );
+            this->members_.emplace_back(key_storage_type(name.begin(),name.end(),get_allocator()), 
+                                  std::forward<T&&>(value),get_allocator());
             it = this->members_.begin() + (this->members_.size() - 1);
+            index_back();
         }
         else if (it->key() == name)
         {
-            it->value(Json(std::forward<T&&>(value),get_allocator() ));
+            it->value(Json(std::forward<T&&>(value),get_allocator()));
         }
         else
         {
             it = this->members_.emplace(it,
-                                  key_storage_type(name.begin(),name.end(), get_allocator()),
-                                  std::forward<T&&>(value),get_allocator() );
+                                  key_storage_type(name.begin(),name.end(),get_allocator()),
+                                  std::forward<T&&>(value),get_allocator());
+            rebuild_index();
         }
         return it;
     }
 
-    template <class T, class U=allocator_type>
-        typename std::enable_if<is_stateless<U>::value,iterator>::type 
-    set_(iterator hint, key_storage_type&& name, T&& value)
-    {
-        string_view_type s(name.data(), name.size());
-        iterator it;
-        if (hint != this->members_.end() && hint->key() <= s)
-        {
-            it = std::lower_bound(hint,this->members_.end(), s, 
-                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        }
-        else
-        {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), s, 
-                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        }
+    template <class T, class U=allocator_type>
+        typename std::enable_if<is_stateless<U>::value,iterator>::type 
+    set_(iterator hint, key_storage_type&& name, T&& value)
+    {
+        iterator it = hint;
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
                                   std::forward<T&&>(value));
             it = this->members_.begin() + (this->members_.size() - 1);
+            index_back();
         }
-        else if (string_view_type(it->key().data(), it->key().length()) == s)
+        else if (it->key() == name)
         {
             it->value(Json(std::forward<T&&>(value)));
         }
@@ -985,6 +2322,7 @@ public:
             it = this->members_.emplace(it,
                                   std::forward<key_storage_type&&>(name),
                                   std::forward<T&&>(value));
+            rebuild_index();
         }
         return it;
     }
@@ -993,34 +2331,25 @@ public:
         typename std::enable_if<!is_stateless<U>::value,iterator>::type 
     set_(iterator hint, key_storage_type&& name, T&& value)
     {
-        string_view_type s(name.data(), name.size());
-        iterator it;
-        if (hint != this->members_.end() && hint->key() <= s)
-        {
-            it = std::lower_bound(hint,this->members_.end(), s, 
-                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        }
-        else
-        {
-            it = std::lower_bound(this->members_.begin(),this->members_.end(), s, 
-                                  [](const value_type& a, string_view_type k){return a.key().compare(k) < 0;});        
-        }
+        iterator it = hint;
 
         if (it == this->members_.end())
         {
             this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
-                                  std::forward<T&&>(value),get_allocator() );
+                                  std::forward<T&&>(value), get_allocator());
             it = this->members_.begin() + (this->members_.size() - 1);
+            index_back();
         }
-        else if (string_view_type(it->key().data(), it->key().length()) == s)
+        else if (it->key() == name)
         {
-            it->value(Json(std::forward<T&&>(value),get_allocator() ));
+            it->value(Json(std::forward<T&&>(value), get_allocator()));
         }
         else
         {
             it = this->members_.emplace(it,
                                   std::forward<key_storage_type&&>(name),
-                                  std::forward<T&&>(value),get_allocator() );
+                                  std::forward<T&&>(value), get_allocator());
+            rebuild_index();
         }
         return it;
     }
@@ -1033,10 +2362,8 @@ public:
         }
         for (auto it = this->members_.begin(); it != this->members_.end(); ++it)
         {
-
-            auto rhs_it = std::lower_bound(rhs.begin(), rhs.end(), *it, 
-                                           [](const value_type& a, const value_type& b){return a.key().compare(b.key()) < 0;});
-            if (rhs_it == rhs.end() || rhs_it->key() != it->key() || rhs_it->value() != it->value())
+            auto rhs_it = rhs.find(it->key());
+            if (rhs_it == rhs.end() || rhs_it->value() != it->value())
             {
                 return false;
             }
@@ -1045,11 +2372,106 @@ public:
     }
 private:
     json_object& operator=(const json_object&) = delete;
+
+    // Returns size() if there is no member with this name
+
+    size_t find_position(string_view_type name) const
+    {
+        if (index_.empty())
+        {
+            return std::find_if(this->members_.begin(),this->members_.end(), 
+                                [name](const value_type& kvp){return kvp.key_equals(name);}) - this->members_.begin();
+        }
+        return index_.find(this->members_, name);
+    }
+
+    // After a member has been added at the end
+
+    void index_back()
+    {
+        if (!index_.empty())
+        {
+            index_.push_back(this->members_);
+        }
+        else if (this->members_.size() >= index_threshold)
+        {
+            index_.rebuild(this->members_);
+        }
+    }
+
+    // After members have been inserted or erased before the end
+
+    void rebuild_index()
+    {
+        if (this->members_.size() < index_threshold)
+        {
+            index_.clear();
+        }
+        else
+        {
+            index_.rebuild(this->members_);
+        }
+    }
+
+    // Removes all but the last member with each name, and keeps the order
+    // of the rest, in linear time
+
+    void remove_duplicates()
+    {
+        size_t count = this->members_.size();
+        std::vector<bool> keep(count, false);
+        std::vector<uint32_t> seen;
+        {
+            size_t capacity = 2*index_threshold;
+            while (capacity < 2*count)
+            {
+                capacity *= 2;
+            }
+            seen.assign(capacity, 0);
+        }
+        size_t mask = seen.size() - 1;
+        for (size_t pos = count; pos-- > 0;)
+        {
+            string_view_type name = this->members_[pos].key();
+            size_t i = hash_string(name.data(), name.length()) & mask;
+            bool found = false;
+            while (!found && seen[i] != 0)
+            {
+                found = this->members_[seen[i] - 1].key_equals(name);
+                i = (i + 1) & mask;
+            }
+            if (!found)
+            {
+                seen[i] = static_cast<uint32_t>(pos + 1);
+                keep[pos] = true;
+            }
+        }
+        size_t last = 0;
+        for (size_t pos = 0; pos < count; ++pos)
+        {
+            if (keep[pos])
+            {
+                if (last != pos)
+                {
+                    this->members_[last] = std::move(this->members_[pos]);
+                }
+                ++last;
+            }
+        }
+        this->members_.erase(this->members_.begin() + last, this->members_.end());
+        rebuild_index();
+    }
 };
 
-// Preserve order
+// Hashed objects
+
+// Members are kept in the order they were added, except that erasing a member
+// moves the last member into its place. Objects with more than a few members
+// find members by name with an object_index, so set, find and erase by name
+// take constant time on average.
+
 template <class KeyT,class Json>
-class json_object<KeyT,Json,true> : public Json_object_<KeyT,Json>
+class hashed_json_object : public Json_object_<KeyT,Json>
 {
 public:
     using typename Json_object_<KeyT,Json>::allocator_type;
@@ -1064,36 +2486,43 @@ public:
     using typename Json_object_<KeyT,Json>::const_iterator;
     using Json_object_<KeyT,Json>::get_allocator;
 
-    json_object()
+    // Objects with at least this many members have an index
+    static const size_t index_threshold = 8;
+private:
+    object_index<allocator_type> index_;
+public:
+
+    hashed_json_object()
         : Json_object_<KeyT,Json>()
     {
     }
-    json_object(const allocator_type& allocator)
-        : Json_object_<KeyT,Json>(allocator)
+    hashed_json_object(const allocator_type& allocator)
+        : Json_object_<KeyT,Json>(allocator), index_(allocator)
     {
     }
 
-    json_object(const json_object& val)
-        : Json_object_<KeyT,Json>(val)
+    hashed_json_object(const hashed_json_object& val)
+        : Json_object_<KeyT,Json>(val), index_(val.index_)
     {
     }
 
-    json_object(json_object&& val)
-        : Json_object_<KeyT,Json>(std::forward<json_object&&>(val))
+    hashed_json_object(hashed_json_object&& val)
+        : Json_object_<KeyT,Json>(std::forward<hashed_json_object&&>(val)), index_(std::move(val.index_))
     {
     }
 
-    json_object(const json_object& val, const allocator_type& allocator) 
-        : Json_object_<KeyT,Json>(val,allocator)
+    hashed_json_object(const hashed_json_object& val, const allocator_type& allocator) 
+        : Json_object_<KeyT,Json>(val,allocator), index_(val.index_,allocator)
     {
     }
 
-    json_object(json_object&& val,const allocator_type& allocator) 
-        : Json_object_<KeyT,Json>(std::forward<json_object&&>(val),allocator)
+    hashed_json_object(hashed_json_object&& val,const allocator_type& allocator) 
+        : Json_object_<KeyT,Json>(std::forward<hashed_json_object&&>(val),allocator), 
+          index_(std::move(val.index_),allocator)
     {
     }
 
-    json_object(std::initializer_list<typename Json::array> init)
+    hashed_json_object(std::initializer_list<typename Json::array> init)
         : Json_object_<KeyT,Json>()
     {
         for (const auto& element : init)
@@ -1110,9 +2539,9 @@ public:
         }
     }
 
-    json_object(std::initializer_list<typename Json::array> init, 
-                const allocator_type& allocator)
-        : Json_object_<KeyT,Json>(allocator)
+    hashed_json_object(std::initializer_list<typename Json::array> init, 
+                       const allocator_type& allocator)
+        : Json_object_<KeyT,Json>(allocator), index_(allocator)
     {
         for (const auto& element : init)
         {
@@ -1128,9 +2557,10 @@ public:
         }
     }
 
-    void swap(json_object& val)
+    void swap(hashed_json_object& val)
     {
         Json_object_<KeyT,Json>::swap(val);
+        index_.swap(val.index_);
     }
 
     iterator begin()
@@ -1157,7 +2587,11 @@ public:
 
     size_t capacity() const {return this->members_.capacity();}
 
-    void clear() {this->members_.clear();}
+    void clear() 
+    {
+        this->members_.clear();
+        index_.clear();
+    }
 
     void shrink_to_fit() 
     {
@@ -1190,31 +2624,31 @@ public:
 
     iterator find(string_view_type name)
     {
-        return std::find_if(this->members_.begin(),this->members_.end(), 
-                            [name](const value_type& kvp){return kvp.key() == name;});
+        return this->members_.begin() + find_position(name);
     }
 
     const_iterator find(string_view_type name) const
     {
-        return std::find_if(this->members_.begin(),this->members_.end(), 
-                            [name](const value_type& kvp){return kvp.key() == name;});
+        return this->members_.begin() + find_position(name);
     }
 
     void erase(iterator first, iterator last) 
     {
         this->members_.erase(first,last);
+        rebuild_index();
     }
 
     void erase(string_view_type name) 
     {
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                              [name](const value_type& kvp){return kvp.key() == name;});
-        if (it != this->members_.end())
+        size_t pos = find_position(name);
+        if (pos != this->members_.size())
         {
-            this->members_.erase(it);
+            erase_position(pos);
         }
     }
 
+    // Later members with the same name replace the values of earlier ones
+
     template<class InputIt, class UnaryPredicate>
     void insert(InputIt first, InputIt last, UnaryPredicate pred)
     {
@@ -1222,210 +2656,179 @@ public:
         this->members_.reserve(this->members_.size() + count);
         for (auto s = first; s != last; ++s)
         {
-            this->members_.emplace_back(pred(*s));
+            value_type member(pred(*s));
+            size_t pos = find_position(member.key());
+            if (pos == this->members_.size())
+            {
+                this->members_.emplace_back(std::move(member));
+                index_back();
+            }
+            else
+            {
+                this->members_[pos].value(std::move(member.value()));
+            }
         }
-        auto it = last_wins_unique_sequence(this->members_.begin(), this->members_.end(),
-                              [](const value_type& a, const value_type& b){ return a.key().compare(b.key());});
-        this->members_.erase(it,this->members_.end());
     }
 
-    template <class T, class U=allocator_type,
-        typename std::enable_if<is_stateless<U>::value
-           >::type* = nullptr>
+    template <class T>
     void set(string_view_type name, T&& value)
     {
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [name](const value_type& a){return a.key() == name;});
-
-        if (it == this->members_.end())
+        size_t pos = find_position(name);
+        if (pos == this->members_.size())
         {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end()), 
-                                  std::forward<T&&>(value));
+            add_member(key_storage_type(name.begin(),name.end(),char_allocator_type(get_allocator())), 
+                       std::forward<T&&>(value));
         }
         else
         {
-            it->value(Json(std::forward<T&&>(value)));
+            set_value(pos, std::forward<T&&>(value));
         }
     }
 
-    template <class T, class U=allocator_type,
-        typename std::enable_if<!is_stateless<U>::value
-           >::type* = nullptr>
-    void set(string_view_type name, T&& value)
+    template <class T>
+    void set_(key_storage_type&& name, T&& value)
     {
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [name](const value_type& a){return a.key() == name;});
-
-        if (it == this->members_.end())
+        size_t pos = find_position(string_view_type(name.data(),name.size()));
+        if (pos == this->members_.size())
         {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
-                                  std::forward<T&&>(value),get_allocator());
+            add_member(std::forward<key_storage_type&&>(name), std::forward<T&&>(value));
         }
         else
         {
-            it->value(Json(std::forward<T&&>(value),get_allocator()));
+            set_value(pos, std::forward<T&&>(value));
         }
     }
 
-    template <class T, class U=allocator_type,
-        typename std::enable_if<is_stateless<U>::value
-           >::type* = nullptr>
-    void set_(key_storage_type&& name, T&& value)
+    // The position of a member does not depend on the hint
+
+    template <class T>
+    iterator set(iterator, string_view_type name, T&& value)
     {
-        string_view_type s(name.data(),name.size());
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [s](const value_type& a){return a.key().compare(s) == 0;});
+        set(name, std::forward<T&&>(value));
+        return find(name);
+    }
 
-        if (it == this->members_.end())
+    template <class T>
+    iterator set_(iterator, key_storage_type&& name, T&& value)
+    {
+        size_t pos = find_position(string_view_type(name.data(),name.size()));
+        if (pos == this->members_.size())
         {
-            this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
-                                  std::forward<T&&>(value));
+            add_member(std::forward<key_storage_type&&>(name), std::forward<T&&>(value));
         }
         else
         {
-            it->value(Json(std::forward<T&&>(value)));
+            set_value(pos, std::forward<T&&>(value));
         }
+        return this->members_.begin() + (pos == this->members_.size() ? this->members_.size() - 1 : pos);
     }
 
-    template <class T, class U=allocator_type,
-        typename std::enable_if<!is_stateless<U>::value
-           >::type* = nullptr>
-    void set_(key_storage_type&& name, T&& value)
+    bool operator==(const hashed_json_object& rhs) const
     {
-        string_view_type s(name.data(),name.size());
-        auto it = std::find_if(this->members_.begin(),this->members_.end(), 
-                               [s](const value_type& a){return a.key().compare(s) == 0;});
-
-        if (it == this->members_.end())
+        if (size() != rhs.size())
         {
-            this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
-                                  std::forward<T&&>(value),get_allocator());
+            return false;
         }
-        else
+        for (auto it = this->members_.begin(); it != this->members_.end(); ++it)
         {
-            it->value(Json(std::forward<T&&>(value),get_allocator()));
+            auto rhs_it = rhs.find(it->key());
+            if (rhs_it == rhs.end() || rhs_it->value() != it->value())
+            {
+                return false;
+            }
         }
+        return true;
     }
+private:
+    hashed_json_object& operator=(const hashed_json_object&) = delete;
 
-    template <class T, class U=allocator_type>
-        typename std::enable_if<is_stateless<U>::value,iterator>::type 
-    set(iterator hint, string_view_type name, T&& value)
-    {
-        iterator it = hint;
+    // Returns size() if there is no member with this name
 
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end(), get_allocator()), 
-                                  std::forward<T&&>(value));
-            it = this->members_.begin() + (this->members_.size() - 1);
-        }
-        else if (it->key() == name)
-        {
-            it->value(Json(std::forward<T&&>(value)));
-        }
-        else
+    size_t find_position(string_view_type name) const
+    {
+        if (index_.empty())
         {
-            it = this->members_.emplace(it,
-                                  key_storage_type(name.begin(),name.end()),
-                                  std::forward<T&&>(value));
+            return std::find_if(this->members_.begin(),this->members_.end(), 
+                                [name](const value_type& kvp){return kvp.key_equals(name);}) - this->members_.begin();
         }
-        return it;
+        return index_.find(this->members_, name);
     }
 
     template <class T, class U=allocator_type>
-        typename std::enable_if<!is_stateless<U>::value,iterator>::type 
-    set(iterator hint, string_view_type name, T&& value)
+        typename std::enable_if<is_stateless<U>::value>::type 
+    add_member(key_storage_type&& name, T&& value)
     {
-        iterator it = hint;
+        this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
+                                    std::forward<T&&>(value));
+        index_back();
+    }
 
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(key_storage_type(name.begin(),name.end(),get_allocator()), 
-                                  std::forward<T&&>(value),get_allocator());
-            it = this->members_.begin() + (this->members_.size() - 1);
-        }
-        else if (it->key() == name)
-        {
-            it->value(Json(std::forward<T&&>(value),get_allocator()));
-        }
-        else
-        {
-            it = this->members_.emplace(it,
-                                  key_storage_type(name.begin(),name.end(),get_allocator()),
-                                  std::forward<T&&>(value),get_allocator());
-        }
-        return it;
+    template <class T, class U=allocator_type>
+        typename std::enable_if<!is_stateless<U>::value>::type 
+    add_member(key_storage_type&& name, T&& value)
+    {
+        this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
+                                    std::forward<T&&>(value),get_allocator());
+        index_back();
     }
 
     template <class T, class U=allocator_type>
-        typename std::enable_if<is_stateless<U>::value,iterator>::type 
-    set_(iterator hint, key_storage_type&& name, T&& value)
+        typename std::enable_if<is_stateless<U>::value>::type 
+    set_value(size_t pos, T&& value)
     {
-        iterator it = hint;
+        this->members_[pos].value(Json(std::forward<T&&>(value)));
+    }
 
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
-                                  std::forward<T&&>(value));
-            it = this->members_.begin() + (this->members_.size() - 1);
-        }
-        else if (it->key() == name)
+    template <class T, class U=allocator_type>
+        typename std::enable_if<!is_stateless<U>::value>::type 
+    set_value(size_t pos, T&& value)
+    {
+        this->members_[pos].value(Json(std::forward<T&&>(value),get_allocator()));
+    }
+
+    // The last member takes the place of the erased one
+
+    void erase_position(size_t pos)
+    {
+        size_t last = this->members_.size() - 1;
+        if (!index_.empty())
         {
-            it->value(Json(std::forward<T&&>(value)));
+            index_.erase(this->members_, pos);
+            if (pos != last)
+            {
+                index_.relocate(this->members_, last, pos);
+            }
         }
-        else
+        if (pos != last)
         {
-            it = this->members_.emplace(it,
-                                  std::forward<key_storage_type&&>(name),
-                                  std::forward<T&&>(value));
+            this->members_[pos] = std::move(this->members_[last]);
         }
-        return it;
+        this->members_.pop_back();
     }
 
-    template <class T, class U=allocator_type>
-        typename std::enable_if<!is_stateless<U>::value,iterator>::type 
-    set_(iterator hint, key_storage_type&& name, T&& value)
+    void index_back()
     {
-        iterator it = hint;
-
-        if (it == this->members_.end())
-        {
-            this->members_.emplace_back(std::forward<key_storage_type&&>(name), 
-                                  std::forward<T&&>(value), get_allocator());
-            it = this->members_.begin() + (this->members_.size() - 1);
-        }
-        else if (it->key() == name)
+        if (!index_.empty())
         {
-            it->value(Json(std::forward<T&&>(value), get_allocator()));
+            index_.push_back(this->members_);
         }
-        else
+        else if (this->members_.size() >= index_threshold)
         {
-            it = this->members_.emplace(it,
-                                  std::forward<key_storage_type&&>(name),
-                                  std::forward<T&&>(value), get_allocator());
+            index_.rebuild(this->members_);
         }
-        return it;
     }
 
-    bool operator==(const json_object& rhs) const
+    void rebuild_index()
     {
-        if (size() != rhs.size())
+        if (this->members_.size() < index_threshold)
         {
-            return false;
+            index_.clear();
         }
-        for (auto it = this->members_.begin(); it != this->members_.end(); ++it)
+        else
         {
-            auto rhs_it = std::find_if(rhs.begin(),rhs.end(), 
-                                       [it](const value_type& a){return a.key() == it->key();});
-            if (rhs_it == rhs.end() || rhs_it->key() != it->key() || rhs_it->value() != it->value())
-            {
-                return false;
-            }
+            index_.rebuild(this->members_);
         }
-        return true;
     }
-private:
-    json_object& operator=(const json_object&) = delete;
 };
 
 }
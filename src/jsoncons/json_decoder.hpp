@@ -15,6 +15,7 @@
 #include <memory>
 #include <jsoncons/jsoncons.hpp>
 #include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/interned_key.hpp>
 
 namespace jsoncons {
 
@@ -31,7 +32,7 @@ public:
     typedef typename Json::kvp_type kvp_type;
     typedef typename Json::string_type string_type;
     typedef typename Json::key_storage_type key_storage_type;
-    typedef typename string_type::allocator_type char_allocator;
+    typedef typename Json::char_allocator_type char_allocator;
     typedef typename Json::allocator_type allocator_type;
     typedef typename Json::array array;
     typedef typename array::allocator_type array_allocator;
@@ -52,6 +53,7 @@ public:
     };
     std::vector<stack_item> stack_;
     std::vector<size_t> stack_offsets_;
+    key_pool<key_storage_type> key_pool_;
     bool is_valid_;
 
 public:
@@ -192,12 +194,15 @@ private:
             auto it = stack_.begin() + (stack_offsets_.back()+1);
             auto end = stack_.begin() + top_;
             size_t count = end - it;
-            j.reserve(count);
 
-            while (it != end)
+            if (!j.array_value().pack(it, end, [](const stack_item& item) -> const Json& {return item.value_;}))
             {
-                j.add(std::move(it->value_));
-                ++it;
+                j.reserve(count);
+                while (it != end)
+                {
+                    j.add(std::move(it->value_));
+                    ++it;
+                }
             }
             top_ -= count;
         }
@@ -205,7 +210,7 @@ private:
 
     void do_name(string_view_type name, const basic_parsing_context<char_type>&) override
     {
-        stack_[top_].name_ = key_storage_type(name.begin(),name.end(),sa_);
+        stack_[top_].name_ = key_pool_.make_key(name.data(),name.length(),sa_);
     }
 
     void do_string_value(string_view_type val, const basic_parsing_context<char_type>&) override
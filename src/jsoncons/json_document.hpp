@@ -0,0 +1,428 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_DOCUMENT_HPP
+#define JSONCONS_JSON_DOCUMENT_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <stdexcept>
+#include <cstdint>
+#include <jsoncons/jsoncons.hpp>
+#include <jsoncons/jsoncons_simd.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_structural_parser.hpp>
+
+namespace jsoncons {
+
+template <class Json>
+class json_document;
+
+// json_view
+
+// A value in a json_document. A view is a pointer to the document and a
+// position in its structural index, it is cheap to copy, and is valid as long
+// as the document. Strings, numbers and literals are parsed when they are
+// converted with as<T>() or to_json(), containers are walked when they are
+// navigated.
+
+template <class Json>
+class json_view
+{
+public:
+    typedef typename Json::char_type char_type;
+    typedef typename Json::string_type string_type;
+    typedef typename Json::string_view_type string_view_type;
+
+    class member_type
+    {
+        const json_document<Json>* doc_;
+        size_t pos_;
+    public:
+        member_type(const json_document<Json>* doc, size_t pos)
+            : doc_(doc), pos_(pos)
+        {
+        }
+
+        string_type name() const
+        {
+            return doc_->string_at(pos_);
+        }
+
+        json_view value() const
+        {
+            return json_view(doc_, pos_ + 2);
+        }
+    };
+
+    // Positions are the first structural of an element, or of a member name.
+    // The end position is the closing bracket or brace.
+
+    template <class T, bool IsObject>
+    class iterator_base
+    {
+        const json_document<Json>* doc_;
+        size_t pos_;
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef T reference;
+
+        iterator_base()
+            : doc_(nullptr), pos_(0)
+        {
+        }
+
+        iterator_base(const json_document<Json>* doc, size_t pos)
+            : doc_(doc), pos_(pos)
+        {
+        }
+
+        T operator*() const
+        {
+            return T(doc_, pos_);
+        }
+
+        size_t position() const
+        {
+            return pos_;
+        }
+
+        iterator_base& operator++()
+        {
+            size_t next = doc_->next(IsObject ? pos_ + 2 : pos_);
+            pos_ = doc_->char_at(next) == ',' ? next + 1 : next;
+            return *this;
+        }
+
+        iterator_base operator++(int)
+        {
+            iterator_base temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const iterator_base& other) const
+        {
+            return pos_ == other.pos_;
+        }
+
+        bool operator!=(const iterator_base& other) const
+        {
+            return pos_ != other.pos_;
+        }
+    };
+
+    typedef iterator_base<member_type,true> object_iterator;
+    typedef iterator_base<json_view,false> array_iterator;
+
+private:
+    const json_document<Json>* doc_;
+    size_t pos_;
+public:
+    json_view(const json_document<Json>* doc, size_t pos)
+        : doc_(doc), pos_(pos)
+    {
+    }
+
+    bool is_object() const
+    {
+        return doc_->char_at(pos_) == '{';
+    }
+
+    bool is_array() const
+    {
+        return doc_->char_at(pos_) == '[';
+    }
+
+    bool is_string() const
+    {
+        return doc_->char_at(pos_) == '\"';
+    }
+
+    bool is_number() const
+    {
+        char_type c = doc_->char_at(pos_);
+        return c == '-' || (c >= '0' && c <= '9');
+    }
+
+    bool is_bool() const
+    {
+        char_type c = doc_->char_at(pos_);
+        return c == 't' || c == 'f';
+    }
+
+    bool is_null() const
+    {
+        return doc_->char_at(pos_) == 'n';
+    }
+
+    size_t size() const
+    {
+        if (is_object())
+        {
+            return std::distance(object_range().begin(), object_range().end());
+        }
+        else if (is_array())
+        {
+            return std::distance(array_range().begin(), array_range().end());
+        }
+        return 0;
+    }
+
+    range<object_iterator> object_range() const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW_EXCEPTION(std::runtime_error,"Not an object");
+        }
+        return range<object_iterator>(object_iterator(doc_, first_child()),
+                                      object_iterator(doc_, doc_->next(pos_) - 1));
+    }
+
+    range<array_iterator> array_range() const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW_EXCEPTION(std::runtime_error,"Not an array");
+        }
+        return range<array_iterator>(array_iterator(doc_, first_child()),
+                                     array_iterator(doc_, doc_->next(pos_) - 1));
+    }
+
+    bool has_key(string_view_type name) const
+    {
+        size_t pos;
+        return is_object() && find(name, pos);
+    }
+
+    json_view at(string_view_type name) const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW_EXCEPTION_1(std::runtime_error,"Attempting to get %s from a value that is not an object", name);
+        }
+        size_t pos;
+        if (!find(name, pos))
+        {
+            JSONCONS_THROW_EXCEPTION_1(std::out_of_range,"%s not found", name);
+        }
+        return json_view(doc_, pos);
+    }
+
+    json_view at(size_t i) const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW_EXCEPTION(std::runtime_error,"Index on non-array value not supported");
+        }
+        auto r = array_range();
+        auto it = r.begin();
+        for (; it != r.end() && i > 0; ++it, --i)
+        {
+        }
+        if (it == r.end())
+        {
+            JSONCONS_THROW_EXCEPTION(std::out_of_range,"Invalid array subscript");
+        }
+        return *it;
+    }
+
+    json_view operator[](string_view_type name) const
+    {
+        return at(name);
+    }
+
+    json_view operator[](size_t i) const
+    {
+        return at(i);
+    }
+
+    // Parses the value, and for an object or array everything in it, into a Json
+
+    Json to_json() const
+    {
+        return doc_->json_at(pos_);
+    }
+
+    template <class T>
+    T as() const
+    {
+        return to_json().template as<T>();
+    }
+
+private:
+    // For an empty object or array this is the end position
+
+    size_t first_child() const
+    {
+        return pos_ + 1;
+    }
+
+    bool find(string_view_type name, size_t& pos) const
+    {
+        auto r = object_range();
+        for (auto it = r.begin(); it != r.end(); ++it)
+        {
+            if (doc_->name_equals(it.position(), name))
+            {
+                pos = it.position() + 2;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// json_document
+
+// A lazily parsed JSON text. On construction the text is checked for valid
+// UTF-8, a structural index is built, and the arrangement of objects, arrays,
+// names, colons and commas is checked, with the errors of
+// basic_json_structural_parser. Strings, numbers and literals are parsed, and
+// their errors reported, only when they are used. The document does not copy
+// the text, which must exist as long as the document and its views. Views
+// share the document's parser, so a document must not be used by several
+// threads at once.
+
+template <class Json>
+class json_document
+{
+    friend class json_view<Json>;
+public:
+    typedef typename Json::char_type char_type;
+    typedef typename Json::string_type string_type;
+    typedef typename Json::string_view_type string_view_type;
+    typedef json_view<Json> view_type;
+private:
+    const char_type* input_;
+    size_t length_;
+    basic_structural_index<char_type> index_;
+    std::vector<uint32_t> ends_;
+    mutable json_decoder<Json> decoder_;
+    mutable basic_json_structural_parser<char_type> parser_;
+
+    // Noncopyable and nonmoveable
+    json_document(const json_document&) = delete;
+    json_document& operator=(const json_document&) = delete;
+public:
+    json_document(string_view_type s)
+        : input_(nullptr), length_(0), parser_(decoder_)
+    {
+        parse(s.data(), s.length());
+    }
+
+    json_document(const char_type* s, size_t length)
+        : input_(nullptr), length_(0), parser_(decoder_)
+    {
+        parse(s, length);
+    }
+
+    view_type root() const
+    {
+        return view_type(this, 0);
+    }
+
+private:
+    void parse(const char_type* s, size_t length)
+    {
+        if (length > basic_structural_index<char_type>::max_length())
+        {
+            JSONCONS_THROW_EXCEPTION(std::runtime_error,"Text too long for json_document");
+        }
+        basic_null_json_input_handler<char_type> handler;
+        basic_json_structural_parser<char_type> parser(handler);
+        input_ = parser.parse_structure(s, length, index_);
+        length_ = length - (input_ - s);
+
+        // The structure is valid, so the brackets match
+        ends_.resize(index_.size());
+        std::vector<uint32_t> stack;
+        for (size_t i = 0; i < index_.size(); ++i)
+        {
+            switch (input_[index_[i]])
+            {
+            case '[':
+            case '{':
+                stack.push_back(static_cast<uint32_t>(i));
+                break;
+            case ']':
+            case '}':
+                ends_[stack.back()] = static_cast<uint32_t>(i + 1);
+                stack.pop_back();
+                break;
+            }
+        }
+    }
+
+    char_type char_at(size_t pos) const
+    {
+        return input_[index_[pos]];
+    }
+
+    // The index position after the value that starts at pos
+
+    size_t next(size_t pos) const
+    {
+        switch (char_at(pos))
+        {
+        case '[':
+        case '{':
+            return ends_[pos];
+        default:
+            return pos + 1;
+        }
+    }
+
+    Json json_at(size_t pos) const
+    {
+        parser_.parse_value(input_, length_, index_, pos, next(pos));
+        return decoder_.get_result();
+    }
+
+    // Strings without escapes are compared and returned without parsing
+
+    bool raw_string_at(size_t pos, string_view_type& s) const
+    {
+        const char_type* p = input_ + index_[pos] + 1;
+        bool is_ascii = true;
+        const char_type* q = simd::find_string_special(p, input_ + length_, is_ascii);
+        if (q == input_ + length_ || *q != '\"')
+        {
+            return false;
+        }
+        s = string_view_type(p, q - p);
+        return true;
+    }
+
+    string_type string_at(size_t pos) const
+    {
+        string_view_type s;
+        if (raw_string_at(pos, s))
+        {
+            return string_type(s.data(), s.length());
+        }
+        return json_at(pos).template as<string_type>();
+    }
+
+    bool name_equals(size_t pos, string_view_type name) const
+    {
+        string_view_type s;
+        if (raw_string_at(pos, s))
+        {
+            return s == name;
+        }
+        return json_at(pos).template as<string_type>() == name;
+    }
+};
+
+}
+
+#endif
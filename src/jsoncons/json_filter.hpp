@@ -304,6 +304,10 @@ private:
                  const basic_parsing_context<CharT>& context) override
     {
         downstream_handler_.name(name,context);
+        if (downstream_handler_.skip_value_requested())
+        {
+            this->skip_value();
+        }
     }
 
     void do_string_value(string_view_type value,
@@ -402,6 +406,10 @@ private:
         {
             this->downstream_handler().name(name,context);
         }
+        if (this->downstream_handler().skip_value_requested())
+        {
+            this->skip_value();
+        }
     }
 };
 
@@ -19,6 +19,7 @@ class basic_parsing_context;
 template <class CharT>
 class basic_json_input_handler
 {
+    bool skip_value_;
 public:
     typedef CharT char_type;
     typedef std::char_traits<char_type> char_traits_type;
@@ -29,8 +30,32 @@ public:
     typedef std::basic_string_view<char_type,char_traits_type> string_view_type;
 #endif
 
+    basic_json_input_handler()
+        : skip_value_(false)
+    {
+    }
+
     virtual ~basic_json_input_handler() {}
 
+    // May be called while handling a name event, to have the parser skip the
+    // member's value without sending any events for it. The skipped value is 
+    // only checked for balanced brackets and braces.
+
+    void skip_value()
+    {
+        skip_value_ = true;
+    }
+
+    // Returns true if skip_value has been called since the last call, for parsers
+    // and filters that pass the request on
+
+    bool skip_value_requested()
+    {
+        bool requested = skip_value_;
+        skip_value_ = false;
+        return requested;
+    }
+
     void begin_json()
     {
         do_begin_json();
@@ -0,0 +1,535 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_LINES_READER_HPP
+#define JSONCONS_JSON_LINES_READER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <istream>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <system_error>
+#include <jsoncons/jsoncons.hpp>
+#include <jsoncons/jsoncons_simd.hpp>
+#include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+
+namespace jsoncons {
+
+// Reads newline delimited JSON (JSON Lines), one JSON text per line. The
+// stream is read in large batches, the line boundaries in a batch are found
+// with a vectorized scan for line feeds, and the lines are parsed on a pool
+// of threads. Values are returned in the order of the lines. Empty lines,
+// and lines containing only white space, are skipped.
+
+template<class CharT>
+class basic_json_lines_reader
+{
+    static const size_t default_buffer_capacity = 1024*1024;
+    static const size_t records_per_task = 16;
+
+    struct record
+    {
+        size_t offset;
+        size_t length;
+        size_t line;
+    };
+
+    // Runs a task on a fixed set of threads and on the calling thread, and
+    // waits for all of them to return. If the task throws on any thread, run
+    // rethrows the first exception after the others have returned.
+
+    class worker_pool
+    {
+        std::vector<std::thread> threads_;
+        std::mutex mutex_;
+        std::condition_variable start_;
+        std::condition_variable done_;
+        const std::function<void()>* task_;
+        size_t generation_;
+        size_t running_;
+        bool stop_;
+        std::exception_ptr error_;
+    public:
+        worker_pool(size_t num_workers)
+            : task_(nullptr), generation_(0), running_(0), stop_(false)
+        {
+            threads_.reserve(num_workers);
+            try
+            {
+                for (size_t i = 0; i < num_workers; ++i)
+                {
+                    threads_.emplace_back([this](){work();});
+                }
+            }
+            catch (...)
+            {
+                // The destructor does not run, so stop the workers that started
+                stop();
+                throw;
+            }
+        }
+
+        ~worker_pool()
+        {
+            stop();
+        }
+
+        size_t size() const
+        {
+            return threads_.size();
+        }
+
+        void run(const std::function<void()>& task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                task_ = &task;
+                running_ = threads_.size();
+                ++generation_;
+            }
+            start_.notify_all();
+            std::exception_ptr error;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this](){return running_ == 0;});
+            task_ = nullptr;
+            if (!error)
+            {
+                error = error_;
+            }
+            error_ = nullptr;
+            lock.unlock();
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    private:
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            start_.notify_all();
+            for (auto& t : threads_)
+            {
+                t.join();
+            }
+        }
+
+        void work()
+        {
+            size_t generation = 0;
+            for (;;)
+            {
+                const std::function<void()>* task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    start_.wait(lock, [&](){return stop_ || generation_ != generation;});
+                    if (stop_)
+                    {
+                        return;
+                    }
+                    generation = generation_;
+                    task = task_;
+                }
+                std::exception_ptr error;
+                try
+                {
+                    (*task)();
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (error && !error_)
+                    {
+                        error_ = error;
+                    }
+                    if (--running_ == 0)
+                    {
+                        done_.notify_one();
+                    }
+                }
+            }
+        }
+    };
+
+    // Forwards to the error handler that the reader was constructed with,
+    // one call at a time
+
+    class locked_error_handler : public basic_parse_error_handler<CharT>
+    {
+        basic_parse_error_handler<CharT>& err_handler_;
+        std::mutex mutex_;
+    public:
+        locked_error_handler(basic_parse_error_handler<CharT>& err_handler)
+            : err_handler_(err_handler)
+        {
+        }
+    private:
+        bool do_error(std::error_code ec,
+                      const basic_parsing_context<CharT>& context) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            try
+            {
+                err_handler_.error(ec, context);
+            }
+            catch (const parse_exception&)
+            {
+                return true;
+            }
+            return false;
+        }
+
+        void do_fatal_error(std::error_code ec,
+                            const basic_parsing_context<CharT>& context) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            try
+            {
+                err_handler_.fatal_error(ec, context);
+            }
+            catch (const parse_exception&)
+            {
+            }
+        }
+    };
+
+    std::basic_istream<CharT>& is_;
+    std::unique_ptr<locked_error_handler> err_handler_;
+    size_t num_threads_;
+    size_t buffer_capacity_;
+    size_t max_nesting_depth_;
+    std::vector<CharT> buffer_;
+    size_t buffer_length_;
+    size_t line_begin_;
+    size_t line_number_;
+    bool eof_;
+    std::vector<record> records_;
+    size_t record_index_;
+    std::unique_ptr<worker_pool> pool_;
+
+    // Noncopyable and nonmoveable
+    basic_json_lines_reader(const basic_json_lines_reader&) = delete;
+    basic_json_lines_reader& operator=(const basic_json_lines_reader&) = delete;
+
+public:
+
+    basic_json_lines_reader(std::basic_istream<CharT>& is)
+        : is_(is),
+          num_threads_(0),
+          buffer_capacity_(default_buffer_capacity),
+          max_nesting_depth_((std::numeric_limits<int>::max)()),
+          buffer_length_(0),
+          line_begin_(0),
+          line_number_(1),
+          eof_(false),
+          record_index_(0)
+    {
+    }
+
+    // The error handler is called from the parsing threads, one call at a
+    // time
+
+    basic_json_lines_reader(std::basic_istream<CharT>& is,
+                            basic_parse_error_handler<CharT>& err_handler)
+        : is_(is),
+          err_handler_(new locked_error_handler(err_handler)),
+          num_threads_(0),
+          buffer_capacity_(default_buffer_capacity),
+          max_nesting_depth_((std::numeric_limits<int>::max)()),
+          buffer_length_(0),
+          line_begin_(0),
+          line_number_(1),
+          eof_(false),
+          record_index_(0)
+    {
+    }
+
+    // The number of threads that parse lines, including the calling thread.
+    // 0 (the default) means std::thread::hardware_concurrency().
+
+    size_t num_threads() const
+    {
+        return num_threads_;
+    }
+
+    void num_threads(size_t count)
+    {
+        num_threads_ = count;
+    }
+
+    // The number of characters read from the stream for each batch of lines
+
+    size_t buffer_capacity() const
+    {
+        return buffer_capacity_;
+    }
+
+    void buffer_capacity(size_t capacity)
+    {
+        buffer_capacity_ = (std::max)(capacity, static_cast<size_t>(1));
+    }
+
+    size_t max_nesting_depth() const
+    {
+        return max_nesting_depth_;
+    }
+
+    void max_nesting_depth(size_t depth)
+    {
+        max_nesting_depth_ = depth;
+    }
+
+    bool eof() const
+    {
+        return eof_ && record_index_ == records_.size();
+    }
+
+    // Reads the next batch of lines, and appends their values to values in
+    // line order. Returns the number of values appended, which is 0 only at
+    // the end of the stream. If a line fails to parse, the values of the lines
+    // before it are appended, and parse_exception is thrown with the line
+    // number in the stream. The next call continues with the following line.
+
+    template <class Json>
+    size_t read_next(std::vector<Json>& values)
+    {
+        while (record_index_ == records_.size() && !eof_)
+        {
+            read_batch();
+        }
+        if (record_index_ == records_.size())
+        {
+            return 0;
+        }
+
+        size_t first = record_index_;
+        size_t count = records_.size() - first;
+        size_t base = values.size();
+        values.resize(base + count);
+        std::vector<std::exception_ptr> errors(count);
+
+        // Errors in lines are kept in errors, anything else that throws in a
+        // task, such as std::bad_alloc, fails the whole batch
+        std::atomic<size_t> next(0);
+        std::exception_ptr task_error;
+        std::mutex task_error_mutex;
+        std::function<void()> task = [&]()
+        {
+            try
+            {
+                json_decoder<Json> decoder;
+                std::unique_ptr<basic_json_parser<CharT>> parser(err_handler_ == nullptr
+                    ? new basic_json_parser<CharT>(decoder)
+                    : new basic_json_parser<CharT>(decoder, *err_handler_));
+                parser->max_nesting_depth(max_nesting_depth_);
+
+                size_t i;
+                while ((i = next.fetch_add(records_per_task)) < count)
+                {
+                    size_t last = (std::min)(i + records_per_task, count);
+                    for (; i < last; ++i)
+                    {
+                        parse_record(*parser, decoder, records_[first + i], values[base + i], errors[i]);
+                    }
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(task_error_mutex);
+                if (!task_error)
+                {
+                    task_error = std::current_exception();
+                }
+            }
+        };
+        run(task, count);
+
+        if (task_error)
+        {
+            // The batch is read again by the next call
+            values.resize(base);
+            std::rethrow_exception(task_error);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (errors[i])
+            {
+                values.resize(base + i);
+                record_index_ = first + i + 1;
+                std::rethrow_exception(errors[i]);
+            }
+        }
+        record_index_ = records_.size();
+        return count;
+    }
+
+    // Reads the rest of the stream, and calls f with each value in line order,
+    // on the calling thread
+
+    template <class Json, class F>
+    void read(F f)
+    {
+        std::vector<Json> values;
+        while (!eof())
+        {
+            values.clear();
+            read_next(values);
+            for (auto& val : values)
+            {
+                f(val);
+            }
+        }
+    }
+
+private:
+
+    void read_batch()
+    {
+        // Move the unfinished line to the front of the buffer
+        std::copy(buffer_.data() + line_begin_, buffer_.data() + buffer_length_, buffer_.data());
+        buffer_length_ -= line_begin_;
+        line_begin_ = 0;
+        records_.clear();
+        record_index_ = 0;
+
+        size_t scanned = buffer_length_;
+        while (records_.empty() && !eof_)
+        {
+            // Read at least as much as is already buffered, so the buffer grows
+            // geometrically for long lines
+            size_t read_length = (std::max)(buffer_capacity_, buffer_length_);
+            if (buffer_.size() < buffer_length_ + read_length)
+            {
+                buffer_.resize(buffer_length_ + read_length);
+            }
+            is_.read(buffer_.data() + buffer_length_, read_length);
+            size_t count = static_cast<size_t>(is_.gcount());
+            if (count == 0)
+            {
+                eof_ = true;
+                add_record(line_begin_, buffer_length_);
+                line_begin_ = buffer_length_;
+                break;
+            }
+            buffer_length_ += count;
+
+            const CharT* data = buffer_.data();
+            const CharT* end = data + buffer_length_;
+            const CharT* p = data + scanned;
+            while ((p = simd::find_newline(p, end)) != end)
+            {
+                add_record(line_begin_, p - data);
+                line_begin_ = (p - data) + 1;
+                ++p;
+            }
+            scanned = buffer_length_;
+        }
+    }
+
+    void add_record(size_t begin, size_t end)
+    {
+        size_t line = line_number_++;
+        const CharT* data = buffer_.data();
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (data[i] != ' ' && data[i] != '\t' && data[i] != '\r')
+            {
+                record r = {begin, end - begin, line};
+                records_.push_back(r);
+                return;
+            }
+        }
+    }
+
+    void run(const std::function<void()>& task, size_t count)
+    {
+        size_t num_threads = num_threads_ != 0 ? num_threads_ : std::thread::hardware_concurrency();
+        size_t num_tasks = (count + records_per_task - 1) / records_per_task;
+        if (num_threads <= 1 || num_tasks <= 1)
+        {
+            task();
+            return;
+        }
+        if (!pool_ || pool_->size() != num_threads - 1)
+        {
+            pool_.reset();
+            try
+            {
+                pool_.reset(new worker_pool(num_threads - 1));
+            }
+            catch (const std::system_error&)
+            {
+                // No threads to be had, parse on the calling thread
+                task();
+                return;
+            }
+        }
+        pool_->run(task);
+    }
+
+    template <class Json>
+    void parse_record(basic_json_parser<CharT>& parser,
+                      json_decoder<Json>& decoder,
+                      const record& r,
+                      Json& value,
+                      std::exception_ptr& error)
+    {
+        try
+        {
+            parser.reset();
+            parser.set_source(buffer_.data() + r.offset, r.length);
+            if (r.line == 1)
+            {
+                parser.skip_bom();
+            }
+            parser.parse();
+            parser.end_parse();
+            parser.check_done();
+            value = decoder.get_result();
+        }
+        catch (const parse_exception& e)
+        {
+            error = std::make_exception_ptr(parse_exception(e.code(), r.line + e.line_number() - 1, e.column_number()));
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+    }
+};
+
+typedef basic_json_lines_reader<char> json_lines_reader;
+typedef basic_json_lines_reader<wchar_t> wjson_lines_reader;
+
+}
+
+#endif
@@ -10,43 +10,24 @@
 #include <string>
 #include <jsoncons/jsoncons.hpp>
 #include <jsoncons/jsoncons_util.hpp>
+#include <jsoncons/integer_to_decimal.hpp>
 
 namespace jsoncons {
 
-template<class CharT> 
-void print_integer(int64_t value, buffered_output<CharT>& os)
+template<class Sink> 
+void print_integer(int64_t value, Sink& os)
 {
-    CharT buf[255];
-    uint64_t u = (value < 0) ? static_cast<uint64_t>(-value) : static_cast<uint64_t>(value);
-    CharT* p = buf;
-    do
-    {
-        *p++ = static_cast<CharT>(48 + u%10);
-    }
-    while (u /= 10);
-    if (value < 0)
-    {
-        os.put('-');
-    }
-    while (--p >= buf)
-    {
-        os.put(*p);
-    }
+    typename Sink::char_type buf[integer_to_decimal_max_length];
+    size_t length = integer_to_decimal(value, buf);
+    os.write(buf, length);
 }
 
-template<class CharT>
-void print_uinteger(uint64_t value, buffered_output<CharT>& os)
+template<class Sink>
+void print_uinteger(uint64_t value, Sink& os)
 {
-    CharT buf[255];
-    CharT* p = buf;
-    do
-    {
-        *p++ = static_cast<CharT>(48 + value % 10);
-    } while (value /= 10);
-    while (--p >= buf)
-    {
-        os.put(*p);
-    }
+    typename Sink::char_type buf[integer_to_decimal_max_length];
+    size_t length = uinteger_to_decimal(value, buf);
+    os.write(buf, length);
 }
 
 template <class CharT>
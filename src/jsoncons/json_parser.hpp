@@ -16,6 +16,7 @@
 #include <stdexcept>
 #include <system_error>
 #include <jsoncons/jsoncons.hpp>
+#include <jsoncons/jsoncons_simd.hpp>
 #include <jsoncons/json_input_handler.hpp>
 #include <jsoncons/parse_error_handler.hpp>
 #include <jsoncons/json_error_category.hpp>
@@ -144,9 +145,23 @@ enum class parse_state
     f,  
     cr,
     lf,
+    skip_value,
+    skip_container,
+    skip_string,
+    skip_escape,
+    skip_scalar,
     done
 };
 
+// Result of basic_json_parser::feed and basic_json_parser::finish
+
+enum class feed_status
+{
+    need_more,
+    document_done,
+    error
+};
+
 template<class CharT>
 class basic_json_parser : private basic_parsing_context<CharT>
 {
@@ -159,6 +174,7 @@ class basic_json_parser : private basic_parsing_context<CharT>
     uint32_t cp_;
     uint32_t cp2_;
     std::basic_string<CharT> string_buffer_;
+    uint64_t integer_value_;
     bool is_negative_;
 
     size_t line_;
@@ -174,6 +190,13 @@ class basic_json_parser : private basic_parsing_context<CharT>
     std::pair<const CharT*,size_t> literal_;
     uint8_t precision_;
     size_t literal_index_;
+    bool defer_partial_strings_;
+    size_t deferred_length_;
+    bool deferred_is_ascii_;
+    bool begin_feed_;
+    std::error_code feed_error_;
+    bool skip_next_value_;
+    size_t skip_depth_;
 
     // Noncopyable and nonmoveable
     basic_json_parser(const basic_json_parser&) = delete;
@@ -186,16 +209,23 @@ public:
          err_handler_(default_err_handler_),
          cp_(0),
          cp2_(0),
+         integer_value_(0),
          is_negative_(false),
          line_(1),
          column_(1),
          nesting_depth_(0), 
          initial_stack_capacity_(default_initial_stack_capacity_),
-         precision_(0), 
-         literal_index_(0),
          begin_input_(nullptr),
          end_input_(nullptr),
-         p_(nullptr)
+         p_(nullptr),
+         precision_(0), 
+         literal_index_(0),
+         defer_partial_strings_(false),
+         deferred_length_(0),
+         deferred_is_ascii_(true),
+         begin_feed_(true),
+         skip_next_value_(false),
+         skip_depth_(0)
     {
         max_depth_ = (std::numeric_limits<int>::max)();
 
@@ -210,16 +240,23 @@ public:
          err_handler_(err_handler),
          cp_(0),
          cp2_(0),
+         integer_value_(0),
          is_negative_(false),
          line_(1),
          column_(1),
          nesting_depth_(0), 
          initial_stack_capacity_(default_initial_stack_capacity_),
-         precision_(0), 
-         literal_index_(0),
          begin_input_(nullptr),
          end_input_(nullptr),
-         p_(nullptr)
+         p_(nullptr),
+         precision_(0), 
+         literal_index_(0),
+         defer_partial_strings_(false),
+         deferred_length_(0),
+         deferred_is_ascii_(true),
+         begin_feed_(true),
+         skip_next_value_(false),
+         skip_depth_(0)
     {
         max_depth_ = (std::numeric_limits<int>::max)();
 
@@ -252,6 +289,29 @@ public:
         max_depth_ = static_cast<int>((std::min)(max_nesting_depth,static_cast<size_t>((std::numeric_limits<int>::max)())));
     }
 
+    // If true, a string without escapes that is not finished at the end of the
+    // source is not copied to an internal buffer. Instead deferred_length()
+    // reports how many characters at the end of the source belong to it, and the
+    // next source passed to set_source must begin with those characters. The
+    // string can then be passed to the handler as a pointer into the source.
+    // feed ignores this setting, since it does not reference a chunk after
+    // returning.
+
+    bool defer_partial_strings() const
+    {
+        return defer_partial_strings_;
+    }
+
+    void defer_partial_strings(bool value)
+    {
+        defer_partial_strings_ = value;
+    }
+
+    size_t deferred_length() const
+    {
+        return deferred_length_;
+    }
+
     parse_state parent() const
     {
         return stack_[stack_.size()-2];
@@ -262,13 +322,90 @@ public:
         return stack_.back() == parse_state::done;
     }
 
-    void do_space()
+    // Skips a run of white space starting at p_ and counts the line breaks in it.
+    // Leaves p_ on the last white space character, which the caller consumes. A 
+    // line break at the end of the source is left to the cr and lf states, so that 
+    // a \r\n pair split across two sources counts once.
+
+    void skip_whitespace()
+    {
+        if (stack_.back() == parse_state::done)
+        {
+            // After the root value, stop at the first line break, parse()
+            // returns there and check_done looks at the rest. The line break 
+            // is counted here so the parser is left in the done state.
+            skip_trailing_whitespace();
+            return;
+        }
+
+        const CharT* p = p_;
+        size_t column = column_;
+        for (;;)
+        {
+            if (*p == '\n')
+            {
+                if (p + 1 == end_input_)
+                {
+                    stack_.push_back(parse_state::lf);
+                    break;
+                }
+                ++line_;
+                column = 0;
+            }
+            else if (*p == '\r')
+            {
+                if (p + 1 == end_input_)
+                {
+                    stack_.push_back(parse_state::cr);
+                    break;
+                }
+                if (*(p + 1) == '\n')
+                {
+                    ++p;
+                }
+                ++line_;
+                column = 0;
+            }
+            if (p + 1 == end_input_)
+            {
+                break;
+            }
+            CharT c = *(p + 1);
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+            {
+                break;
+            }
+            ++p;
+            ++column;
+        }
+        p_ = p;
+        column_ = column;
+    }
+
+    void skip_trailing_whitespace()
     {
-        while ((p_ + 1) < end_input_ && (*(p_ + 1) == ' ' || *(p_ + 1) == '\t')) 
-        {                                      
-            ++p_;                          
-            ++column_;                     
-        }                                      
+        switch (*p_)
+        {
+        case '\r':
+            if ((p_ + 1) < end_input_ && *(p_ + 1) == '\n')
+            {
+                ++p_;
+            }
+            ++line_;
+            column_ = 0;
+            break;
+        case '\n':
+            ++line_;
+            column_ = 0;
+            break;
+        default:
+            while ((p_ + 1) < end_input_ && (*(p_ + 1) == ' ' || *(p_ + 1) == '\t')) 
+            {                                      
+                ++p_;                          
+                ++column_;                     
+            }                                      
+            break;
+        }
     }
 
     void do_begin_object()
@@ -361,6 +498,13 @@ public:
         line_ = 1;
         column_ = 1;
         nesting_depth_ = 0;
+        deferred_length_ = 0;
+        string_buffer_.clear();
+        is_negative_ = false;
+        begin_feed_ = true;
+        feed_error_ = std::error_code();
+        skip_next_value_ = false;
+        skip_depth_ = 0;
     }
 
     void check_done()
@@ -390,8 +534,23 @@ public:
     {
         const CharT* sb = p_;
         bool done = false;
+        bool is_ascii = true;
+        if (deferred_length_ > 0)
+        {
+            // The source begins with the part of the string that was already scanned
+            p_ += deferred_length_;
+            is_ascii = deferred_is_ascii_;
+            deferred_length_ = 0;
+        }
         while (!done && p_ < end_input_)
         {
+            // Skip plain content in bulk, stopping at the next character
+            // that the switch below has to look at
+            p_ = simd::find_string_special(p_, end_input_, is_ascii);
+            if (p_ == end_input_)
+            {
+                break;
+            }
             switch (*p_)
             {
             case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b:
@@ -446,7 +605,8 @@ public:
             case '\"':
                 if (string_buffer_.length() == 0)
                 {
-                    auto result = unicons::validate(sb,p_);
+                    // An all ASCII string needs no further validation
+                    auto result = is_ascii ? std::make_pair(unicons::conv_errc::ok,p_) : simd::validate(sb,p_);
                     if (result.first == unicons::conv_errc::ok)
                     {
                         end_string_value(sb,p_-sb);
@@ -459,7 +619,7 @@ public:
                 else
                 {
                     string_buffer_.append(sb,p_-sb);
-                    auto result = unicons::validate(string_buffer_.begin(),string_buffer_.end());
+                    auto result = simd::validate(string_buffer_.data(),string_buffer_.data()+string_buffer_.length());
                     if (result.first == unicons::conv_errc::ok)
                     {
                         end_string_value(string_buffer_.data(),string_buffer_.length());
@@ -481,8 +641,16 @@ public:
         }
         if (!done)
         {
-            string_buffer_.append(sb,p_-sb);
-            column_ += (p_ - sb + 1);
+            if (defer_partial_strings_ && string_buffer_.length() == 0)
+            {
+                deferred_length_ = p_ - sb;
+                deferred_is_ascii_ = is_ascii;
+            }
+            else
+            {
+                string_buffer_.append(sb,p_-sb);
+                column_ += (p_ - sb + 1);
+            }
         }
     }
 
@@ -578,14 +746,8 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        do_space();
+                    case ' ':case '\t':case '\n':case '\r':
+                        skip_whitespace();
                         break;
                     case '/': 
                         stack_.push_back(parse_state::slash);
@@ -609,12 +771,12 @@ public:
                         break;
                     case '0': 
                         handler_.begin_json();
-                        string_buffer_.push_back(static_cast<char>(*p_));
+                        integer_value_ = static_cast<uint64_t>(*p_ - '0');
                         stack_.back() = parse_state::zero;
                         break;
                     case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                         handler_.begin_json();
-                        string_buffer_.push_back(static_cast<char>(*p_));
+                        integer_value_ = static_cast<uint64_t>(*p_ - '0');
                         stack_.back() = parse_state::integer;
                         break;
                     case 'f':
@@ -654,14 +816,8 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        do_space();
+                    case ' ':case '\t':case '\n':case '\r':
+                        skip_whitespace();
                         break;
                     case '/': 
                         stack_.push_back(parse_state::slash);
@@ -695,14 +851,8 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        do_space();
+                    case ' ':case '\t':case '\n':case '\r':
+                        skip_whitespace();
                         break;
                     case '/': 
                         stack_.push_back(parse_state::slash);
@@ -729,14 +879,8 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        do_space();
+                    case ' ':case '\t':case '\n':case '\r':
+                        skip_whitespace();
                         break;
                     case '/': 
                         stack_.push_back(parse_state::slash);
@@ -764,20 +908,15 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        do_space();
+                    case ' ':case '\t':case '\n':case '\r':
+                        skip_whitespace();
                         break;
                     case '/': 
                         stack_.push_back(parse_state::slash);
                         break;
                     case ':':
-                        stack_.back() = parse_state::expect_value;
+                        stack_.back() = skip_next_value_ ? parse_state::skip_value : parse_state::expect_value;
+                        skip_next_value_ = false;
                         break;
                     default:
                         err_handler_.error(json_parser_errc::expected_colon, *this);
@@ -787,18 +926,51 @@ public:
                 ++p_;
                 ++column_;
                 break;
+            case parse_state::skip_value: 
+                {
+                    switch (*p_)
+                    {
+                    case ' ':case '\t':case '\n':case '\r':
+                        skip_whitespace();
+                        break;
+                    case '/': 
+                        stack_.push_back(parse_state::slash);
+                        break;
+                    case '{':
+                    case '[':
+                        skip_depth_ = 1;
+                        stack_.back() = parse_state::skip_container;
+                        break;
+                    case '\"':
+                        skip_depth_ = 0;
+                        stack_.back() = parse_state::skip_string;
+                        break;
+                    case '}':
+                    case ']':
+                    case ',':
+                    case ':':
+                        err_handler_.error(json_parser_errc::expected_value, *this);
+                        break;
+                    default:
+                        stack_.back() = parse_state::skip_scalar;
+                        break;
+                    }
+                }
+                ++p_;
+                ++column_;
+                break;
+            case parse_state::skip_container: 
+            case parse_state::skip_string: 
+            case parse_state::skip_escape: 
+            case parse_state::skip_scalar: 
+                skip_value();
+                break;
             case parse_state::expect_value: 
                 {
                     switch (*p_)
                     {
-                    case '\r': 
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        do_space();
+                    case ' ':case '\t':case '\n':case '\r':
+                        skip_whitespace();
                         break;
                     case '/': 
                         stack_.push_back(parse_state::slash);
@@ -817,11 +989,11 @@ public:
                         stack_.back() = parse_state::minus;
                         break;
                     case '0': 
-                        string_buffer_.push_back(static_cast<char>(*p_));
+                        integer_value_ = static_cast<uint64_t>(*p_ - '0');
                         stack_.back() = parse_state::zero;
                         break;
                     case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                        string_buffer_.push_back(static_cast<char>(*p_));
+                        integer_value_ = static_cast<uint64_t>(*p_ - '0');
                         stack_.back() = parse_state::integer;
                         break;
                     case 'f':
@@ -866,14 +1038,8 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        do_space();
+                    case ' ':case '\t':case '\n':case '\r':
+                        skip_whitespace();
                         break;
                     case '/': 
                         stack_.push_back(parse_state::slash);
@@ -895,11 +1061,11 @@ public:
                         stack_.back() = parse_state::minus;
                         break;
                     case '0': 
-                        string_buffer_.push_back(static_cast<char>(*p_));
+                        integer_value_ = static_cast<uint64_t>(*p_ - '0');
                         stack_.back() = parse_state::zero;
                         break;
                     case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                        string_buffer_.push_back(static_cast<char>(*p_));
+                        integer_value_ = static_cast<uint64_t>(*p_ - '0');
                         stack_.back() = parse_state::integer;
                         break;
                     case 'f':
@@ -1048,11 +1214,11 @@ public:
                     switch (*p_)
                     {
                     case '0': 
-                        string_buffer_.push_back(static_cast<char>(*p_));
+                        integer_value_ = static_cast<uint64_t>(*p_ - '0');
                         stack_.back() = parse_state::zero;
                         break;
                     case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                        string_buffer_.push_back(static_cast<char>(*p_));
+                        integer_value_ = static_cast<uint64_t>(*p_ - '0');
                         stack_.back() = parse_state::integer;
                         break;
                     default:
@@ -1067,17 +1233,9 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
-                        end_integer_value();
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        end_integer_value();
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
+                    case ' ':case '\t':case '\n':case '\r':
                         end_integer_value();
-                        do_space();
+                        skip_whitespace();
                         break;
                     case '/': 
                         end_integer_value();
@@ -1092,11 +1250,13 @@ public:
                         do_end_array();
                         break;
                     case '.':
+                        integer_digits_to_buffer();
                         precision_ = static_cast<uint8_t>(string_buffer_.length());
                         string_buffer_.push_back(static_cast<char>(*p_));
                         stack_.back() = parse_state::fraction1;
                         break;
                     case 'e':case 'E':
+                        integer_digits_to_buffer();
                         precision_ = static_cast<uint8_t>(string_buffer_.length());
                         string_buffer_.push_back(static_cast<char>(*p_));
                         stack_.back() = parse_state::exp1;
@@ -1120,17 +1280,9 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
+                    case ' ':case '\t':case '\n':case '\r':
                         end_integer_value();
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        end_integer_value();
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        end_integer_value();
-                        do_space();
+                        skip_whitespace();
                         break;
                     case '/': 
                         end_integer_value();
@@ -1146,10 +1298,11 @@ public:
                         break;
                     case '0': 
                     case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                        string_buffer_.push_back(static_cast<char>(*p_));
+                        push_integer_digit(*p_);
                         stack_.back() = parse_state::integer;
                         break;
                     case '.':
+                        integer_digits_to_buffer();
                         precision_ = static_cast<uint8_t>(string_buffer_.length());
                         string_buffer_.push_back(static_cast<char>(*p_));
                         stack_.back() = parse_state::fraction1;
@@ -1159,6 +1312,7 @@ public:
                         begin_member_or_element();
                         break;
                     case 'e':case 'E':
+                        integer_digits_to_buffer();
                         precision_ = static_cast<uint8_t>(string_buffer_.length());
                         string_buffer_.push_back(static_cast<char>(*p_));
                         stack_.back() = parse_state::exp1;
@@ -1193,17 +1347,9 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
+                    case ' ':case '\t':case '\n':case '\r':
                         end_fraction_value();
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        end_fraction_value();
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        end_fraction_value();
-                        do_space();
+                        skip_whitespace();
                         break;
                     case '/': 
                         end_fraction_value();
@@ -1284,17 +1430,9 @@ public:
                 {
                     switch (*p_)
                     {
-                    case '\r': 
+                    case ' ':case '\t':case '\n':case '\r':
                         end_fraction_value();
-                        stack_.push_back(parse_state::cr);
-                        break; 
-                    case '\n': 
-                        end_fraction_value();
-                        stack_.push_back(parse_state::lf); 
-                        break;   
-                    case ' ':case '\t':
-                        end_fraction_value();
-                        do_space();
+                        skip_whitespace();
                         break;
                     case '/': 
                         end_fraction_value();
@@ -1521,6 +1659,90 @@ public:
         end_input_ = input + length;
         p_ = begin_input_;
     }
+
+    // Push interface for non-blocking input. feed parses the next chunk of a 
+    // document. The chunk may end anywhere, including inside a token, and is not 
+    // referenced after feed returns. Returns need_more when the chunk is used 
+    // up and the document is not finished, document_done when the root value is 
+    // complete, with unconsumed() characters of the chunk left over, or error. 
+    // After document_done or error, call reset() before feeding the next document.
+
+    feed_status feed(const CharT* data, size_t length)
+    {
+        set_source(data, length);
+        if (feed_error_)
+        {
+            return feed_status::error;
+        }
+        if (stack_.back() == parse_state::done)
+        {
+            return feed_status::document_done;
+        }
+        bool defer_partial_strings = defer_partial_strings_;
+        defer_partial_strings_ = false;
+        try
+        {
+            if (begin_feed_ && length > 0)
+            {
+                skip_bom();
+                begin_feed_ = false;
+            }
+            parse();
+        }
+        catch (const parse_exception& e)
+        {
+            defer_partial_strings_ = defer_partial_strings;
+            feed_error_ = e.code();
+            return feed_status::error;
+        }
+        catch (...)
+        {
+            defer_partial_strings_ = defer_partial_strings;
+            throw;
+        }
+        defer_partial_strings_ = defer_partial_strings;
+        return stack_.back() == parse_state::done ? feed_status::document_done : feed_status::need_more;
+    }
+
+    // Signals the end of the input. Completes a root value that can only end 
+    // there, such as a number, and returns document_done or error.
+
+    feed_status finish()
+    {
+        if (feed_error_)
+        {
+            return feed_status::error;
+        }
+        set_source(end_input_, 0);
+        try
+        {
+            end_parse();
+        }
+        catch (const parse_exception& e)
+        {
+            feed_error_ = e.code();
+            return feed_status::error;
+        }
+        if (stack_.back() != parse_state::done)
+        {
+            feed_error_ = json_parser_errc::unexpected_eof;
+            return feed_status::error;
+        }
+        return feed_status::document_done;
+    }
+
+    size_t unconsumed() const
+    {
+        return end_input_ - p_;
+    }
+
+    // The error that made feed or finish return error, its position is given
+    // by parsing_context()
+
+    std::error_code feed_error() const
+    {
+        return feed_error_;
+    }
 private:
     void end_fraction_value()
     {
@@ -1556,48 +1778,75 @@ private:
         }
     }
 
-    void end_integer_value()
+    // Integer digits are accumulated in integer_value_ while it does not
+    // overflow and string_buffer_ is empty, after that they go to string_buffer_
+
+    void push_integer_digit(CharT c)
     {
-        if (is_negative_)
+        static const uint64_t max_value = (std::numeric_limits<uint64_t>::max)();
+        static const uint64_t max_value_div_10 = max_value / 10;
+
+        uint64_t x = static_cast<uint64_t>(c - '0');
+        if (string_buffer_.empty())
         {
-            int64_t d;
-            if (try_string_to_integer(is_negative_, string_buffer_.data(), string_buffer_.length(),d))
+            if (integer_value_ < max_value_div_10 || 
+                (integer_value_ == max_value_div_10 && x <= max_value % 10))
             {
-                handler_.value(d, *this);
+                integer_value_ = integer_value_*10 + x;
+                return;
             }
-            else
+            integer_digits_to_buffer();
+        }
+        string_buffer_.push_back(static_cast<char>(c));
+    }
+
+    // JSON integers have no leading zeros, so the digits can be recovered from the value
+
+    void integer_digits_to_buffer()
+    {
+        if (string_buffer_.empty())
+        {
+            CharT buf[20];
+            CharT* p = buf + 20;
+            uint64_t n = integer_value_;
+            do
             {
-                try
-                {
-                    double d2 = str_to_double_(string_buffer_.data(), string_buffer_.length());
-                    handler_.value(-d2, static_cast<uint8_t>(string_buffer_.length()), *this);
-                }
-                catch (...)
-                {
-                    err_handler_.error(json_parser_errc::invalid_number, *this);
-                    handler_.value(null_type(), *this);
-                }
+                *--p = static_cast<CharT>('0' + n % 10);
+                n /= 10;
             }
+            while (n != 0);
+            string_buffer_.append(p, buf + 20);
+        }
+    }
+
+    void end_integer_value()
+    {
+        static const uint64_t min_value_magnitude = static_cast<uint64_t>(1) << 63;
+
+        if (string_buffer_.empty() && !is_negative_)
+        {
+            handler_.value(integer_value_, *this);
+        }
+        else if (string_buffer_.empty() && integer_value_ < min_value_magnitude)
+        {
+            handler_.value(-static_cast<int64_t>(integer_value_), *this);
+        }
+        else if (string_buffer_.empty() && integer_value_ == min_value_magnitude)
+        {
+            handler_.value((std::numeric_limits<int64_t>::min)(), *this);
         }
         else
         {
-            uint64_t d;
-            if (try_string_to_uinteger(string_buffer_.data(), string_buffer_.length(),d))
+            integer_digits_to_buffer();
+            try
             {
-                handler_.value(d, *this);
+                double d = str_to_double_(string_buffer_.data(), string_buffer_.length());
+                handler_.value(is_negative_ ? -d : d, static_cast<uint8_t>(string_buffer_.length()), *this);
             }
-            else
+            catch (...)
             {
-                try
-                {
-                    double d2 = str_to_double_(string_buffer_.data(),string_buffer_.length());
-                    handler_.value(d2, static_cast<uint8_t>(string_buffer_.length()), *this);
-                }
-                catch (...)
-                {
-                    err_handler_.error(json_parser_errc::invalid_number, *this);
-                    handler_.value(null_type(), *this);
-                }
+                err_handler_.error(json_parser_errc::invalid_number, *this);
+                handler_.value(null_type(), *this);
             }
         }
 
@@ -1697,6 +1946,116 @@ private:
         }
     }
 
+    // Fast forwards over a member value that the handler asked to skip. Only
+    // quotation marks, escapes, brackets and braces are looked at, so the
+    // value is not checked, and no events are sent for it.
+
+    void skip_value()
+    {
+        const CharT* p = p_;
+        size_t column = column_;
+        parse_state state = stack_.back();
+
+        while (p < end_input_)
+        {
+            switch (state)
+            {
+            case parse_state::skip_string:
+                {
+                    bool is_ascii = true;
+                    const CharT* q = simd::find_string_special(p, end_input_, is_ascii);
+                    column += q - p;
+                    p = q;
+                    if (p == end_input_)
+                    {
+                        break;
+                    }
+                    if (*p == '\"')
+                    {
+                        state = skip_depth_ > 0 ? parse_state::skip_container : parse_state::done;
+                    }
+                    else if (*p == '\\')
+                    {
+                        state = parse_state::skip_escape;
+                    }
+                    ++p;
+                    ++column;
+                }
+                break;
+            case parse_state::skip_escape:
+                state = parse_state::skip_string;
+                ++p;
+                ++column;
+                break;
+            case parse_state::skip_container:
+                for (; p < end_input_ && state == parse_state::skip_container; ++p, ++column)
+                {
+                    switch (*p)
+                    {
+                    case '\"':
+                        state = parse_state::skip_string;
+                        break;
+                    case '{':
+                    case '[':
+                        ++skip_depth_;
+                        break;
+                    case '}':
+                    case ']':
+                        if (--skip_depth_ == 0)
+                        {
+                            state = parse_state::done;
+                        }
+                        break;
+                    case '\n':
+                        ++line_;
+                        column = 0;
+                        break;
+                    case '\r':
+                        if (p + 1 == end_input_)
+                        {
+                            // Counted by the cr state, which also skips a following '\n'
+                            p_ = p + 1;
+                            column_ = column + 1;
+                            stack_.back() = state;
+                            stack_.push_back(parse_state::cr);
+                            return;
+                        }
+                        if (*(p + 1) == '\n')
+                        {
+                            ++p;
+                        }
+                        ++line_;
+                        column = 0;
+                        break;
+                    }
+                }
+                break;
+            case parse_state::skip_scalar:
+                switch (*p)
+                {
+                case ',':case '}':case ']':case ' ':case '\t':case '\n':case '\r':case '/':
+                    state = parse_state::done;
+                    break;
+                default:
+                    ++p;
+                    ++column;
+                    break;
+                }
+                break;
+            default:
+                break;
+            }
+            if (state == parse_state::done)
+            {
+                state = parse_state::expect_comma_or_end;
+                break;
+            }
+        }
+        p_ = p;
+        column_ = column;
+        stack_.back() = state;
+    }
+
     void end_string_value(const CharT* s, size_t length) 
     {
         JSONCONS_ASSERT(stack_.size() >= 2);
@@ -1704,6 +2063,7 @@ private:
         {
         case parse_state::member_name:
             handler_.name(s, length, *this);
+            skip_next_value_ = handler_.skip_value_requested();
             stack_.pop_back();
             stack_.back() = parse_state::expect_colon;
             break;
@@ -11,6 +11,7 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <algorithm>
 #include <istream>
 #include <cstdlib>
 #include <stdexcept>
@@ -51,6 +52,7 @@ public:
           begin_(true)
     {
         buffer_.resize(buffer_capacity_);
+        parser_.defer_partial_strings(true);
     }
 
     basic_json_reader(std::basic_istream<CharT>& is,
@@ -64,6 +66,7 @@ public:
          begin_(true)
     {
         buffer_.resize(buffer_capacity_);
+        parser_.defer_partial_strings(true);
     }
 
     size_t buffer_capacity() const
@@ -77,6 +80,21 @@ public:
         buffer_.resize(buffer_capacity_);
     }
 
+    // If true (the default), a string that crosses the end of the buffer is moved 
+    // to the front of the buffer before the next read, so that the handler receives 
+    // strings without escapes as pointers into the buffer rather than copies. The 
+    // buffer grows as needed to hold the longest such string.
+
+    bool contiguous_strings() const
+    {
+        return parser_.defer_partial_strings();
+    }
+
+    void contiguous_strings(bool value)
+    {
+        parser_.defer_partial_strings(value);
+    }
+
     size_t max_nesting_depth() const
     {
         return parser_.max_nesting_depth();
@@ -96,9 +114,7 @@ public:
             {
                 if (!is_.eof())
                 {
-                    is_.read(buffer_.data(), buffer_capacity_);
-                    buffer_length_ = static_cast<size_t>(is_.gcount());
-                    parser_.set_source(buffer_.data(),buffer_length_);
+                    read_buffer();
                     if (buffer_length_ == 0)
                     {
                         eof_ = true;
@@ -182,6 +198,29 @@ public:
         parser_.max_nesting_depth(depth);
     }
 #endif
+private:
+
+    void read_buffer()
+    {
+        // Slide the unfinished string forward, and read at least buffer_capacity_ 
+        // characters after it, so the buffer grows geometrically for long strings
+        size_t deferred_length = parser_.deferred_length();
+        if (deferred_length > 0)
+        {
+            std::copy(buffer_.data() + buffer_length_ - deferred_length, 
+                      buffer_.data() + buffer_length_, 
+                      buffer_.data());
+        }
+        size_t read_length = (std::max)(buffer_capacity_, deferred_length);
+        if (buffer_.size() < deferred_length + read_length)
+        {
+            buffer_.resize(deferred_length + read_length);
+        }
+        is_.read(buffer_.data() + deferred_length, read_length);
+        size_t count = static_cast<size_t>(is_.gcount());
+        buffer_length_ = count == 0 ? 0 : deferred_length + count;
+        parser_.set_source(buffer_.data(),buffer_length_);
+    }
 };
 
 typedef basic_json_reader<char> json_reader;
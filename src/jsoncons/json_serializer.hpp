@@ -19,14 +19,18 @@
 #include <jsoncons/jsoncons_util.hpp>
 #include <jsoncons/serialization_options.hpp>
 #include <jsoncons/json_output_handler.hpp>
+#include <jsoncons/output_sinks.hpp>
 
 namespace jsoncons {
 
-template<class CharT>
+template<class CharT,class Sink=buffered_output<CharT>>
 class basic_json_serializer : public basic_json_output_handler<CharT>
 {
+    static_assert(std::is_same<CharT,typename Sink::char_type>::value, "Sink must write CharT");
 public:
     using typename basic_json_output_handler<CharT>::string_view_type                                 ;
+    typedef Sink sink_type;
+    typedef typename Sink::output_type output_type;
 
 private:
     static const size_t default_buffer_length = 16384;
@@ -83,13 +87,13 @@ private:
     int indent_;
     bool indenting_;
     print_double<CharT> fp_;
-    buffered_output<CharT> bos_;
+    Sink bos_;
 
     // Noncopyable and nonmoveable
     basic_json_serializer(const basic_json_serializer&) = delete;
     basic_json_serializer& operator=(const basic_json_serializer&) = delete;
 public:
-    basic_json_serializer(std::basic_ostream<CharT>& os)
+    basic_json_serializer(output_type os)
        : indent_(0), 
          indenting_(false),
          fp_(format_.precision()),
@@ -97,7 +101,7 @@ public:
     {
     }
 
-    basic_json_serializer(std::basic_ostream<CharT>& os, bool indenting)
+    basic_json_serializer(output_type os, bool indenting)
        : indent_(0), 
          indenting_(indenting),
          fp_(format_.precision()),
@@ -105,7 +109,7 @@ public:
     {
     }
 
-    basic_json_serializer(std::basic_ostream<CharT>& os, const basic_serialization_options<CharT>& options)
+    basic_json_serializer(output_type os, const basic_serialization_options<CharT>& options)
        : format_(options), 
          indent_(0), 
          indenting_(false),  
@@ -113,7 +117,7 @@ public:
          bos_(os)
     {
     }
-    basic_json_serializer(std::basic_ostream<CharT>& os, const basic_serialization_options<CharT>& options, bool indenting)
+    basic_json_serializer(output_type os, const basic_serialization_options<CharT>& options, bool indenting)
        : format_(options), 
          indent_(0), 
          indenting_(indenting),  
@@ -330,15 +334,18 @@ private:
 
         if ((std::isnan)(value))
         {
-            bos_.write(format_.nan_replacement());
+            auto s = format_.nan_replacement();
+            bos_.write(s.data(),s.length());
         }
         else if (value == std::numeric_limits<double>::infinity())
         {
-            bos_.write(format_.pos_inf_replacement());
+            auto s = format_.pos_inf_replacement();
+            bos_.write(s.data(),s.length());
         }
         else if (!(std::isfinite)(value))
         {
-            bos_.write(format_.neg_inf_replacement());
+            auto s = format_.neg_inf_replacement();
+            bos_.write(s.data(),s.length());
         }
         else
         {
@@ -0,0 +1,1183 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_STRUCTURAL_PARSER_HPP
+#define JSONCONS_JSON_STRUCTURAL_PARSER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <jsoncons/jsoncons.hpp>
+#include <jsoncons/jsoncons_simd.hpp>
+#include <jsoncons/json_input_handler.hpp>
+#include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons/json_error_category.hpp>
+#include <jsoncons/json_parser.hpp>
+
+namespace jsoncons {
+
+// Selects how basic_json::parse and basic_json::parse_file process an in-memory
+// document. incremental is the byte-at-a-time basic_json_parser, structural is
+// basic_json_structural_parser, with a fallback to incremental for input that
+// it does not accept. parallel is structural, except that a large top-level
+// array is split into ranges of elements that are parsed on several threads.
+enum class parse_engine
+{
+    incremental,
+    structural,
+    parallel
+};
+
+// structural_block
+
+// Character class bit masks for a block of 64 characters, bit i is set if
+// character i of the block belongs to the class.
+
+struct structural_block
+{
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t whitespace;
+    uint64_t op;
+    uint64_t control;
+};
+
+template <class CharT>
+void classify_structural_block(const CharT* p, structural_block& block)
+{
+    typedef typename std::make_unsigned<CharT>::type uchar_type;
+
+    block.quote = 0;
+    block.backslash = 0;
+    block.whitespace = 0;
+    block.op = 0;
+    block.control = 0;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        uchar_type c = static_cast<uchar_type>(p[i]);
+        uint64_t bit = uint64_t(1) << i;
+        switch (c)
+        {
+        case '\"':
+            block.quote |= bit;
+            break;
+        case '\\':
+            block.backslash |= bit;
+            break;
+        case ' ':case '\t':case '\n':case '\r':
+            block.whitespace |= bit;
+            break;
+        case '{':case '}':case '[':case ']':case ':':case ',':
+            block.op |= bit;
+            break;
+        default:
+            break;
+        }
+        if (c < 0x20)
+        {
+            block.control |= bit;
+        }
+    }
+}
+
+#if defined(JSONCONS_HAS_SSE2)
+
+inline
+void classify_structural_block(const char* p, structural_block& block)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lower_case = _mm_set1_epi8(0x20);
+    const __m128i left_brace = _mm_set1_epi8('{');
+    const __m128i right_brace = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i max_control = _mm_set1_epi8(0x1f);
+
+    block.quote = 0;
+    block.backslash = 0;
+    block.whitespace = 0;
+    block.op = 0;
+    block.control = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16*i));
+        // '[' and ']' differ from '{' and '}' only in bit 0x20
+        __m128i folded = _mm_or_si128(v, lower_case);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+        __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, left_brace), _mm_cmpeq_epi8(folded, right_brace)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+        __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(v, max_control), max_control);
+
+        int shift = 16*i;
+        block.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << shift;
+        block.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)))) << shift;
+        block.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(ws))) << shift;
+        block.op |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(op))) << shift;
+        block.control |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(control))) << shift;
+    }
+}
+
+#endif
+
+inline
+uint64_t prefix_xor(uint64_t x)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+inline
+unsigned trailing_zeros64(uint64_t x)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<unsigned>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+    unsigned n = 0;
+    while ((x & 1) == 0)
+    {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// basic_structural_index
+
+// Stage 1 of the structural parser. Records the offsets of the structural
+// characters of a document: the operators {}[]:, outside strings, the
+// opening quotation mark of each string, and the first character of each
+// number or literal. Offsets are 32 bit, so documents are limited to
+// max_length() characters.
+
+template <class CharT>
+class basic_structural_index
+{
+    std::unique_ptr<uint32_t[]> positions_;
+    size_t capacity_;
+    size_t size_;
+    bool unclosed_string_;
+    size_t error_position_;
+    std::error_code ec_;
+public:
+    basic_structural_index()
+        : capacity_(0), size_(0), unclosed_string_(false), error_position_(0)
+    {
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    static size_t max_length()
+    {
+        return (std::numeric_limits<uint32_t>::max)() - 64;
+    }
+
+    size_t operator[](size_t i) const
+    {
+        return positions_[i];
+    }
+
+    bool unclosed_string() const
+    {
+        return unclosed_string_;
+    }
+
+    // If build fails, the error and the offset at which it was detected
+
+    std::error_code error_code() const
+    {
+        return ec_;
+    }
+
+    size_t error_position() const
+    {
+        return error_position_;
+    }
+
+    bool build(const CharT* data, size_t length)
+    {
+        size_ = 0;
+        unclosed_string_ = false;
+        error_position_ = 0;
+        ec_ = std::error_code();
+        JSONCONS_ASSERT(length <= max_length());
+
+        // There cannot be more structurals than characters. The positions are
+        // written as they are found, so untouched capacity costs no memory.
+        if (length + 64 > capacity_)
+        {
+            positions_.reset(new uint32_t[length + 64]);
+            capacity_ = length + 64;
+        }
+
+        uint64_t prev_escaped = 0;     // 1 if the first character of the block is escaped
+        uint64_t prev_in_string = 0;   // all ones if the block starts inside a string
+        uint64_t prev_scalar = 0;      // 1 if the block starts in the middle of a scalar
+        uint64_t bad_control = 0;
+
+        structural_block block;
+        CharT last_block[64];
+
+        for (size_t base = 0; base < length; base += 64)
+        {
+            if (length - base >= 64)
+            {
+                classify_structural_block(data + base, block);
+            }
+            else
+            {
+                std::fill(last_block, last_block + 64, static_cast<CharT>(' '));
+                std::copy(data + base, data + length, last_block);
+                classify_structural_block(last_block, block);
+            }
+
+            // Escaped characters, backslashes are rare so walk them
+            uint64_t escaped = prev_escaped;
+            uint64_t backslash = block.backslash & ~prev_escaped;
+            prev_escaped = 0;
+            while (backslash != 0)
+            {
+                unsigned i = trailing_zeros64(backslash);
+                if (i == 63)
+                {
+                    prev_escaped = 1;
+                    backslash = 0;
+                }
+                else
+                {
+                    escaped |= uint64_t(1) << (i + 1);
+                    backslash &= ~(uint64_t(3) << i);
+                }
+            }
+
+            uint64_t quote = block.quote & ~escaped;
+            uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+            prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+            // in_string covers the opening quotation mark but not the closing one
+            uint64_t string_tail = in_string | quote;
+            uint64_t scalar = ~(block.op | block.whitespace | string_tail);
+            uint64_t scalar_start = scalar & ~((scalar << 1) | prev_scalar);
+            prev_scalar = scalar >> 63;
+
+            uint64_t structurals = (block.op & ~string_tail) | (quote & in_string) | scalar_start;
+
+            bad_control |= (block.control & ~block.whitespace) | (block.control & in_string);
+            if (bad_control != 0)
+            {
+                error_position_ = base + trailing_zeros64(bad_control);
+                ec_ = json_parser_errc::illegal_control_character;
+                return false;
+            }
+
+            uint32_t* out = positions_.get() + size_;
+            while (structurals != 0)
+            {
+                *out++ = static_cast<uint32_t>(base + trailing_zeros64(structurals));
+                structurals &= structurals - 1;
+            }
+            size_ = out - positions_.get();
+        }
+        unclosed_string_ = prev_in_string != 0;
+        if (unclosed_string_)
+        {
+            error_position_ = length;
+            ec_ = json_parser_errc::unexpected_eof;
+            return false;
+        }
+        return true;
+    }
+};
+
+// basic_json_structural_parser
+
+// Parses a complete in-memory document in two stages: a vectorized pass
+// that validates UTF-8 and builds a basic_structural_index, and a pass that
+// walks the index and sends the same events to the input handler as
+// basic_json_parser. Input is limited to basic_structural_index::max_length()
+// characters. Only strict JSON is accepted, comments and all other
+// errors are reported with fatal_error, so there is no error recovery. Line
+// and column numbers are computed from the offset of the error.
+
+template<class CharT>
+class basic_json_structural_parser : private basic_parsing_context<CharT>
+{
+    static const int default_initial_stack_capacity_ = 100;
+
+    enum class structural_state
+    {
+        expect_value,
+        expect_value_or_end,
+        expect_member_name,
+        expect_member_name_or_end,
+        expect_colon,
+        expect_comma_or_end,
+        done
+    };
+
+    basic_default_parse_error_handler<CharT> default_err_handler_;
+    basic_json_input_handler<CharT>& handler_;
+    basic_parse_error_handler<CharT>& err_handler_;
+    basic_structural_index<CharT> index_;
+    std::vector<bool> stack_;  // true for object, false for array
+    std::basic_string<CharT> string_buffer_;
+    string_to_double<CharT> str_to_double_;
+    int max_depth_;
+    bool structure_only_;
+    bool skip_next_value_;
+
+    const CharT* begin_input_;
+    const CharT* end_input_;
+    const CharT* p_;
+
+    mutable const CharT* line_scan_;
+    mutable const CharT* line_begin_;
+    mutable size_t line_;
+
+    // Noncopyable and nonmoveable
+    basic_json_structural_parser(const basic_json_structural_parser&) = delete;
+    basic_json_structural_parser& operator=(const basic_json_structural_parser&) = delete;
+
+public:
+    basic_json_structural_parser(basic_json_input_handler<CharT>& handler)
+       : handler_(handler),
+         err_handler_(default_err_handler_),
+         max_depth_((std::numeric_limits<int>::max)()),
+         structure_only_(false),
+         skip_next_value_(false),
+         begin_input_(nullptr),
+         end_input_(nullptr),
+         p_(nullptr),
+         line_scan_(nullptr),
+         line_begin_(nullptr),
+         line_(1)
+    {
+        stack_.reserve(default_initial_stack_capacity_);
+    }
+
+    basic_json_structural_parser(basic_json_input_handler<CharT>& handler,
+                                 basic_parse_error_handler<CharT>& err_handler)
+       : handler_(handler),
+         err_handler_(err_handler),
+         max_depth_((std::numeric_limits<int>::max)()),
+         structure_only_(false),
+         skip_next_value_(false),
+         begin_input_(nullptr),
+         end_input_(nullptr),
+         p_(nullptr),
+         line_scan_(nullptr),
+         line_begin_(nullptr),
+         line_(1)
+    {
+        stack_.reserve(default_initial_stack_capacity_);
+    }
+
+    const basic_parsing_context<CharT>& parsing_context() const
+    {
+        return *this;
+    }
+
+    size_t max_nesting_depth() const
+    {
+        return static_cast<size_t>(max_depth_);
+    }
+
+    void max_nesting_depth(size_t max_nesting_depth)
+    {
+        max_depth_ = static_cast<int>((std::min)(max_nesting_depth,static_cast<size_t>((std::numeric_limits<int>::max)())));
+    }
+
+    void parse(const CharT* input, size_t length)
+    {
+        // Stage 1
+        build_index(input, length, index_);
+
+        // Stage 2
+        structure_only_ = false;
+        walk_index(index_);
+    }
+
+    // Builds index for input and checks the structure of the document, for 
+    // json_document. Strings, numbers and literals are only checked by their 
+    // first character, they are checked when they are parsed with parse_value.
+    // Returns the start of the input after any byte order mark, offsets in 
+    // the index are relative to it.
+
+    const CharT* parse_structure(const CharT* input, size_t length, basic_structural_index<CharT>& index)
+    {
+        build_index(input, length, index);
+        const CharT* base = p_;
+        structure_only_ = true;
+        walk_index(index);
+        structure_only_ = false;
+        return base;
+    }
+
+    // Parses the value that starts at index position first and ends before 
+    // index position last. index was built for input, and errors are reported
+    // relative to input.
+
+    void parse_value(const CharT* input, size_t length,
+                     const basic_structural_index<CharT>& index,
+                     size_t first, size_t last)
+    {
+        set_input(input, length);
+        p_ = input + index[first];
+        structure_only_ = false;
+
+        handler_.begin_json();
+        structural_state state = walk(index, first, last, input, structural_state::expect_value);
+        if (state != structural_state::done)
+        {
+            p_ = last < index.size() ? input + index[last] : end_input_;
+            err_handler_.fatal_error(json_parser_errc::unexpected_eof, *this);
+        }
+    }
+
+    // Parses some of the elements of a top-level array, for parsing the array 
+    // in parallel. index was built for input, offsets are relative to input,
+    // and first and last are index positions: first is the first structural of 
+    // an element, and last is the comma or closing bracket that ends the range.
+    // The elements are sent to the handler as one array. Only the range is
+    // checked for valid UTF-8. Errors are reported relative to input.
+
+    void parse_array_elements(const CharT* input, size_t length,
+                              const basic_structural_index<CharT>& index,
+                              size_t first, size_t last)
+    {
+        set_input(input, length);
+        p_ = input + index[first];
+        structure_only_ = false;
+
+        auto result = simd::validate(input + index[first], input + index[last]);
+        if (result.first != unicons::conv_errc::ok)
+        {
+            p_ = result.second;
+            conv_error(result.first);
+        }
+
+        handler_.begin_json();
+        begin_structure(false);
+        handler_.begin_array(*this);
+        structural_state state = walk(index, first, last, input, structural_state::expect_value);
+        p_ = input + index[last];
+        if (state != structural_state::expect_comma_or_end || stack_.size() != 1)
+        {
+            err_handler_.fatal_error(json_parser_errc::expected_value, *this);
+        }
+        end_structure(false);
+    }
+
+private:
+    void set_input(const CharT* input, size_t length)
+    {
+        skip_next_value_ = false;
+        begin_input_ = input;
+        end_input_ = input + length;
+        p_ = input;
+        line_scan_ = input;
+        line_begin_ = input;
+        line_ = 1;
+        stack_.clear();
+        string_buffer_.clear();
+    }
+
+    void build_index(const CharT* input, size_t length, basic_structural_index<CharT>& index)
+    {
+        set_input(input, length);
+        skip_bom();
+
+        auto result = simd::validate(p_, end_input_);
+        if (result.first != unicons::conv_errc::ok)
+        {
+            p_ = result.second;
+            conv_error(result.first);
+        }
+        if (!index.build(p_, end_input_ - p_))
+        {
+            p_ += index.error_position();
+            err_handler_.fatal_error(index.error_code(), *this);
+        }
+    }
+
+    void skip_bom()
+    {
+        auto result = unicons::skip_bom(p_, end_input_);
+        switch (result.first)
+        {
+        case unicons::encoding_errc::expected_u8_found_u16:
+            err_handler_.fatal_error(json_parser_errc::expected_u8_found_u16, *this);
+            break;
+        case unicons::encoding_errc::expected_u8_found_u32:
+            err_handler_.fatal_error(json_parser_errc::expected_u8_found_u32, *this);
+            break;
+        case unicons::encoding_errc::expected_u16_found_fffe:
+            err_handler_.fatal_error(json_parser_errc::expected_u16_found_fffe, *this);
+            break;
+        case unicons::encoding_errc::expected_u32_found_fffe:
+            err_handler_.fatal_error(json_parser_errc::expected_u32_found_fffe, *this);
+            break;
+        default: // ok
+            break;
+        }
+        p_ = result.second;
+    }
+
+    void walk_index(const basic_structural_index<CharT>& index)
+    {
+        if (index.size() == 0)
+        {
+            p_ = end_input_;
+            err_handler_.fatal_error(json_parser_errc::unexpected_eof, *this);
+        }
+        handler_.begin_json();
+
+        structural_state state = walk(index, 0, index.size(), p_, structural_state::expect_value);
+        if (state != structural_state::done)
+        {
+            p_ = end_input_;
+            err_handler_.fatal_error(json_parser_errc::unexpected_eof, *this);
+        }
+    }
+
+    structural_state walk(const basic_structural_index<CharT>& index, size_t first, size_t last, 
+                          const CharT* base, structural_state state)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            p_ = base + index[i];
+            switch (state)
+            {
+            case structural_state::expect_value:
+            case structural_state::expect_value_or_end:
+                if (structure_only_ && is_scalar_start(*p_))
+                {
+                    state = end_value();
+                    break;
+                }
+                if (skip_next_value_)
+                {
+                    // Only a member value can be skipped, so the value is not the root
+                    skip_next_value_ = false;
+                    i = skip_value(index, i, last, base);
+                    state = structural_state::expect_comma_or_end;
+                    break;
+                }
+                switch (*p_)
+                {
+                case '{':
+                    begin_structure(true);
+                    handler_.begin_object(*this);
+                    state = structural_state::expect_member_name_or_end;
+                    break;
+                case '[':
+                    begin_structure(false);
+                    handler_.begin_array(*this);
+                    state = structural_state::expect_value_or_end;
+                    break;
+                case ']':
+                    if (state == structural_state::expect_value_or_end)
+                    {
+                        state = end_structure(false);
+                    }
+                    else if (!stack_.empty() && !stack_.back())
+                    {
+                        err_handler_.fatal_error(json_parser_errc::extra_comma, *this);
+                    }
+                    else
+                    {
+                        err_handler_.fatal_error(json_parser_errc::expected_value, *this);
+                    }
+                    break;
+                case '\"':
+                    parse_string(false);
+                    state = end_value();
+                    break;
+                case '-':
+                case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
+                    parse_number();
+                    state = end_value();
+                    break;
+                case 't':
+                    parse_literal(json_literals<CharT>::true_literal());
+                    handler_.value(true, *this);
+                    state = end_value();
+                    break;
+                case 'f':
+                    parse_literal(json_literals<CharT>::false_literal());
+                    handler_.value(false, *this);
+                    state = end_value();
+                    break;
+                case 'n':
+                    parse_literal(json_literals<CharT>::null_literal());
+                    handler_.value(null_type(), *this);
+                    state = end_value();
+                    break;
+                case '}':
+                    if (stack_.empty())
+                    {
+                        err_handler_.fatal_error(json_parser_errc::unexpected_right_brace, *this);
+                    }
+                    err_handler_.fatal_error(json_parser_errc::expected_value, *this);
+                    break;
+                case '/':
+                    err_handler_.fatal_error(json_parser_errc::illegal_comment, *this);
+                    break;
+                case '\'':
+                    err_handler_.fatal_error(json_parser_errc::single_quote, *this);
+                    break;
+                default:
+                    err_handler_.fatal_error(json_parser_errc::expected_value, *this);
+                    break;
+                }
+                break;
+            case structural_state::expect_member_name:
+            case structural_state::expect_member_name_or_end:
+                switch (*p_)
+                {
+                case '\"':
+                    if (!structure_only_)
+                    {
+                        parse_string(true);
+                        skip_next_value_ = handler_.skip_value_requested();
+                    }
+                    state = structural_state::expect_colon;
+                    break;
+                case '}':
+                    if (state == structural_state::expect_member_name_or_end)
+                    {
+                        state = end_structure(true);
+                    }
+                    else
+                    {
+                        err_handler_.fatal_error(json_parser_errc::extra_comma, *this);
+                    }
+                    break;
+                case '\'':
+                    err_handler_.fatal_error(json_parser_errc::single_quote, *this);
+                    break;
+                default:
+                    err_handler_.fatal_error(json_parser_errc::expected_name, *this);
+                    break;
+                }
+                break;
+            case structural_state::expect_colon:
+                if (*p_ != ':')
+                {
+                    err_handler_.fatal_error(json_parser_errc::expected_colon, *this);
+                }
+                state = structural_state::expect_value;
+                break;
+            case structural_state::expect_comma_or_end:
+                switch (*p_)
+                {
+                case ',':
+                    state = stack_.back() ? structural_state::expect_member_name : structural_state::expect_value;
+                    break;
+                case '}':
+                    if (!stack_.back())
+                    {
+                        err_handler_.fatal_error(json_parser_errc::expected_comma_or_right_bracket, *this);
+                    }
+                    state = end_structure(true);
+                    break;
+                case ']':
+                    if (stack_.back())
+                    {
+                        err_handler_.fatal_error(json_parser_errc::expected_comma_or_right_brace, *this);
+                    }
+                    state = end_structure(false);
+                    break;
+                default:
+                    err_handler_.fatal_error(stack_.back() ? json_parser_errc::expected_comma_or_right_brace
+                                                           : json_parser_errc::expected_comma_or_right_bracket, *this);
+                    break;
+                }
+                break;
+            case structural_state::done:
+                err_handler_.fatal_error(json_parser_errc::extra_character, *this);
+                break;
+            }
+        }
+        return state;
+    }
+
+    // Returns the index position of the last structural of the value that starts
+    // at index position i. Nested values are not checked.
+
+    size_t skip_value(const basic_structural_index<CharT>& index, size_t i, size_t last, const CharT* base)
+    {
+        switch (*p_)
+        {
+        case '{':
+        case '[':
+            break;
+        case '}':
+        case ']':
+        case ',':
+        case ':':
+            err_handler_.fatal_error(json_parser_errc::expected_value, *this);
+            return i;
+        default:
+            return i;
+        }
+        size_t depth = 0;
+        for (; i < last; ++i)
+        {
+            switch (base[index[i]])
+            {
+            case '{':
+            case '[':
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                if (--depth == 0)
+                {
+                    return i;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        p_ = end_input_;
+        err_handler_.fatal_error(json_parser_errc::unexpected_eof, *this);
+        return i;
+    }
+
+    void begin_structure(bool is_object)
+    {
+        if (static_cast<int>(stack_.size()) + 1 >= max_depth_)
+        {
+            err_handler_.fatal_error(json_parser_errc::max_depth_exceeded, *this);
+        }
+        stack_.push_back(is_object);
+    }
+
+    structural_state end_structure(bool is_object)
+    {
+        stack_.pop_back();
+        if (is_object)
+        {
+            handler_.end_object(*this);
+        }
+        else
+        {
+            handler_.end_array(*this);
+        }
+        return end_value();
+    }
+
+    structural_state end_value()
+    {
+        if (stack_.empty())
+        {
+            handler_.end_json();
+            return structural_state::done;
+        }
+        return structural_state::expect_comma_or_end;
+    }
+
+    static bool is_scalar_start(CharT c)
+    {
+        switch (c)
+        {
+        case '\"':case '-':case 't':case 'f':case 'n':
+        case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8':case '9':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool is_delimiter(const CharT* p) const
+    {
+        if (p == end_input_)
+        {
+            return true;
+        }
+        switch (*p)
+        {
+        case ' ':case '\t':case '\n':case '\r':
+        case '{':case '}':case '[':case ']':case ':':case ',':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void parse_literal(std::pair<const CharT*,size_t> literal)
+    {
+        if (static_cast<size_t>(end_input_ - p_) < literal.second ||
+            std::char_traits<CharT>::compare(p_, literal.first, literal.second) != 0 ||
+            !is_delimiter(p_ + literal.second))
+        {
+            err_handler_.fatal_error(json_parser_errc::invalid_value, *this);
+        }
+    }
+
+    // Sends the same number events as basic_json_parser, including the
+    // precision that it reports for doubles
+
+    void parse_number()
+    {
+        const CharT* p = p_;
+        bool is_negative = false;
+        if (*p == '-')
+        {
+            is_negative = true;
+            ++p;
+        }
+        const CharT* digits_begin = p;
+        if (p == end_input_ || !(*p >= '0' && *p <= '9'))
+        {
+            err_handler_.fatal_error(json_parser_errc::expected_value, *this);
+        }
+
+        // The integer value is accumulated while scanning, until it overflows
+        static const uint64_t max_value = (std::numeric_limits<uint64_t>::max)();
+        static const uint64_t max_value_div_10 = max_value / 10;
+        uint64_t value = 0;
+        bool overflow = false;
+        if (*p == '0')
+        {
+            ++p;
+            if (p != end_input_ && *p >= '0' && *p <= '9')
+            {
+                err_handler_.fatal_error(json_parser_errc::leading_zero, *this);
+            }
+        }
+        else
+        {
+            for (; p != end_input_ && *p >= '0' && *p <= '9'; ++p)
+            {
+                uint64_t x = static_cast<uint64_t>(*p - '0');
+                if (value < max_value_div_10 || (value == max_value_div_10 && x <= max_value % 10))
+                {
+                    value = value*10 + x;
+                }
+                else
+                {
+                    overflow = true;
+                }
+            }
+        }
+        const CharT* digits_end = p;
+
+        bool is_integer = true;
+        uint8_t precision = static_cast<uint8_t>(digits_end - digits_begin);
+        const CharT* fraction_begin = p;
+        const CharT* fraction_end = p;
+        if (p != end_input_ && *p == '.')
+        {
+            is_integer = false;
+            ++p;
+            fraction_begin = p;
+            while (p != end_input_ && *p >= '0' && *p <= '9')
+            {
+                ++precision;
+                ++p;
+            }
+            fraction_end = p;
+            if (fraction_begin == fraction_end)
+            {
+                err_handler_.fatal_error(json_parser_errc::invalid_number, *this);
+            }
+        }
+        const CharT* exp_begin = p;
+        if (p != end_input_ && (*p == 'e' || *p == 'E'))
+        {
+            is_integer = false;
+            ++p;
+            if (p != end_input_ && (*p == '+' || *p == '-'))
+            {
+                ++p;
+            }
+            const CharT* exp_digits = p;
+            while (p != end_input_ && *p >= '0' && *p <= '9')
+            {
+                ++p;
+            }
+            if (p == exp_digits)
+            {
+                err_handler_.fatal_error(json_parser_errc::expected_value, *this);
+            }
+        }
+        if (!is_delimiter(p))
+        {
+            p_ = p;
+            err_handler_.fatal_error(json_parser_errc::invalid_number, *this);
+        }
+
+        if (is_integer)
+        {
+            static const uint64_t min_value_magnitude = static_cast<uint64_t>(1) << 63;
+
+            size_t length = digits_end - digits_begin;
+            if (!overflow && !is_negative)
+            {
+                handler_.value(value, *this);
+                return;
+            }
+            if (!overflow && value < min_value_magnitude)
+            {
+                handler_.value(-static_cast<int64_t>(value), *this);
+                return;
+            }
+            if (!overflow && value == min_value_magnitude)
+            {
+                handler_.value((std::numeric_limits<int64_t>::min)(), *this);
+                return;
+            }
+            string_buffer_.assign(digits_begin, digits_end);
+            double d = str_to_double_(string_buffer_.c_str(), string_buffer_.length());
+            handler_.value(is_negative ? -d : d, static_cast<uint8_t>(length), *this);
+        }
+        else
+        {
+            // Same text as basic_json_parser buffers: no sign, no '+' in the exponent
+            string_buffer_.assign(digits_begin, digits_end);
+            if (fraction_begin != fraction_end)
+            {
+                string_buffer_.push_back('.');
+                string_buffer_.append(fraction_begin, fraction_end);
+            }
+            for (const CharT* q = exp_begin; q < p; ++q)
+            {
+                if (*q != '+')
+                {
+                    string_buffer_.push_back(*q);
+                }
+            }
+            double d = str_to_double_(string_buffer_.c_str(), precision);
+            handler_.value(is_negative ? -d : d, precision, *this);
+        }
+    }
+
+    void parse_string(bool is_name)
+    {
+        const CharT* sb = p_ + 1;
+        const CharT* p = sb;
+        bool is_ascii = true;
+
+        // Control characters and unterminated strings were rejected in stage 1
+        p = simd::find_string_special(p, end_input_, is_ascii);
+        if (*p == '\"')
+        {
+            end_string(is_name, sb, p - sb);
+            return;
+        }
+
+        string_buffer_.clear();
+        while (*p != '\"')
+        {
+            string_buffer_.append(sb, p);
+            p_ = p;
+            p = parse_escape(p + 1);
+            sb = p;
+            p = simd::find_string_special(p, end_input_, is_ascii);
+        }
+        string_buffer_.append(sb, p);
+        auto result = simd::validate(string_buffer_.data(), string_buffer_.data() + string_buffer_.length());
+        if (result.first != unicons::conv_errc::ok)
+        {
+            p_ = p;
+            conv_error(result.first);
+        }
+        end_string(is_name, string_buffer_.data(), string_buffer_.length());
+    }
+
+    void end_string(bool is_name, const CharT* s, size_t length)
+    {
+        if (is_name)
+        {
+            handler_.name(s, length, *this);
+        }
+        else
+        {
+            handler_.value(s, length, *this);
+        }
+    }
+
+    // Decodes the escape sequence following a reverse solidus, in the same way as
+    // basic_json_parser, and returns the position after it
+
+    const CharT* parse_escape(const CharT* p)
+    {
+        switch (*p)
+        {
+        case '\"':
+            string_buffer_.push_back('\"');
+            break;
+        case '\\':
+            string_buffer_.push_back('\\');
+            break;
+        case '/':
+            string_buffer_.push_back('/');
+            break;
+        case 'b':
+            string_buffer_.push_back('\b');
+            break;
+        case 'f':
+            string_buffer_.push_back('\f');
+            break;
+        case 'n':
+            string_buffer_.push_back('\n');
+            break;
+        case 'r':
+            string_buffer_.push_back('\r');
+            break;
+        case 't':
+            string_buffer_.push_back('\t');
+            break;
+        case 'u':
+            {
+                uint32_t cp = parse_hex4(p + 1);
+                p += 4;
+                if (unicons::is_high_surrogate(cp))
+                {
+                    if (end_input_ - p < 3 || *(p+1) != '\\' || *(p+2) != 'u')
+                    {
+                        p_ = p + 1;
+                        err_handler_.fatal_error(json_parser_errc::expected_codepoint_surrogate_pair, *this);
+                    }
+                    uint32_t cp2 = parse_hex4(p + 3);
+                    p += 6;
+                    uint32_t codepoint = 0x10000 + ((cp & 0x3FF) << 10) + (cp2 & 0x3FF);
+                    unicons::convert(&codepoint, &codepoint + 1, std::back_inserter(string_buffer_));
+                }
+                else
+                {
+                    unicons::convert(&cp, &cp + 1, std::back_inserter(string_buffer_));
+                }
+            }
+            break;
+        default:
+            p_ = p;
+            err_handler_.fatal_error(json_parser_errc::illegal_escaped_character, *this);
+            break;
+        }
+        return p + 1;
+    }
+
+    uint32_t parse_hex4(const CharT* p)
+    {
+        uint32_t cp = 0;
+        for (int i = 0; i < 4; ++i, ++p)
+        {
+            if (p == end_input_)
+            {
+                p_ = p;
+                err_handler_.fatal_error(json_parser_errc::unexpected_eof, *this);
+            }
+            CharT c = *p;
+            cp *= 16;
+            if (c >= '0'  &&  c <= '9')
+            {
+                cp += c - '0';
+            }
+            else if (c >= 'a'  &&  c <= 'f')
+            {
+                cp += c - 'a' + 10;
+            }
+            else if (c >= 'A'  &&  c <= 'F')
+            {
+                cp += c - 'A' + 10;
+            }
+            else
+            {
+                p_ = p;
+                err_handler_.fatal_error(json_parser_errc::invalid_hex_escape_sequence, *this);
+            }
+        }
+        return cp;
+    }
+
+    void conv_error(unicons::conv_errc result)
+    {
+        switch (result)
+        {
+        case unicons::conv_errc::over_long_utf8_sequence:
+            err_handler_.fatal_error(json_parser_errc::over_long_utf8_sequence, *this);
+            break;
+        case unicons::conv_errc::unpaired_high_surrogate:
+            err_handler_.fatal_error(json_parser_errc::unpaired_high_surrogate, *this);
+            break;
+        case unicons::conv_errc::expected_continuation_byte:
+            err_handler_.fatal_error(json_parser_errc::expected_continuation_byte, *this);
+            break;
+        case unicons::conv_errc::illegal_surrogate_value:
+            err_handler_.fatal_error(json_parser_errc::illegal_surrogate_value, *this);
+            break;
+        default:
+            err_handler_.fatal_error(json_parser_errc::illegal_codepoint, *this);
+            break;
+        }
+    }
+
+    // Line numbers are counted on demand, from where the last count stopped
+
+    void count_lines() const
+    {
+        const CharT* p = (std::min)(p_, end_input_);
+        for (; line_scan_ < p; ++line_scan_)
+        {
+            if (*line_scan_ == '\n' ||
+                (*line_scan_ == '\r' && (line_scan_ + 1 == end_input_ || *(line_scan_ + 1) != '\n')))
+            {
+                ++line_;
+                line_begin_ = line_scan_ + 1;
+            }
+        }
+    }
+
+    size_t do_line_number() const override
+    {
+        count_lines();
+        return line_;
+    }
+
+    size_t do_column_number() const override
+    {
+        count_lines();
+        return (std::min)(p_, end_input_) - line_begin_ + 1;
+    }
+
+    CharT do_current_char() const override
+    {
+        return p_ < end_input_ ? *p_ : 0;
+    }
+};
+
+typedef basic_json_structural_parser<char> json_structural_parser;
+typedef basic_json_structural_parser<wchar_t> wjson_structural_parser;
+
+}
+
+#endif
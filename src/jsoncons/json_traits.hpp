@@ -14,8 +14,10 @@
 
 #include <jsoncons/serialization_options.hpp>
 #include <jsoncons/parse_error_handler.hpp>
+#include <jsoncons/interned_key.hpp>
 #include <string>
 #include <vector>
+#include <type_traits>
 
 namespace jsoncons {
 
@@ -49,6 +51,91 @@ struct o_json_traits : public json_traits<CharT>
     static const bool preserve_order = true;
 };
 
+// Object keys are basic_interned_key, and json_decoder makes one copy of each
+// distinct name, which all members with that name share
+
+template <class CharT>
+struct interned_key_json_traits : public json_traits<CharT>
+{
+    template <class Allocator>
+    using key_storage = basic_interned_key<CharT,typename json_traits<CharT>::char_traits_type,Allocator>;
+};
+
+template <class CharT>
+struct o_interned_key_json_traits : public interned_key_json_traits<CharT>
+{
+    static const bool preserve_order = true;
+};
+
+// Objects are hashed_json_object, which keep members in an unspecified order
+// and find them by hashing their names
+
+template <class CharT>
+struct hashed_json_traits : public json_traits<CharT>
+{
+    static const bool hashed_objects = true;
+};
+
+template <class JsonTraits, class Enable = void>
+struct has_hashed_objects : public std::false_type
+{
+};
+
+template <class JsonTraits>
+struct has_hashed_objects<JsonTraits,typename std::enable_if<JsonTraits::hashed_objects>::type> : public std::true_type
+{
+};
+
+// json_decoder stores arrays of doubles or integers in packed_json_array as
+// vectors of numbers, which are unpacked when their elements are accessed
+
+template <class CharT>
+struct packed_json_traits : public json_traits<CharT>
+{
+    static const bool packed_arrays = true;
+};
+
+template <class CharT>
+struct o_packed_json_traits : public packed_json_traits<CharT>
+{
+    static const bool preserve_order = true;
+};
+
+template <class JsonTraits, class Enable = void>
+struct has_packed_arrays : public std::false_type
+{
+};
+
+template <class JsonTraits>
+struct has_packed_arrays<JsonTraits,typename std::enable_if<JsonTraits::packed_arrays>::type> : public std::true_type
+{
+};
+
+// Values are 8 bytes rather than 16 on 64-bit platforms, doubles are stored
+// without a precision, and only strings of up to 4 chars are stored inline
+
+template <class CharT>
+struct compact_json_traits : public json_traits<CharT>
+{
+    static const bool compact_values = true;
+};
+
+template <class CharT>
+struct o_compact_json_traits : public compact_json_traits<CharT>
+{
+    static const bool preserve_order = true;
+};
+
+template <class JsonTraits, class Enable = void>
+struct has_compact_values : public std::false_type
+{
+};
+
+template <class JsonTraits>
+struct has_compact_values<JsonTraits,typename std::enable_if<JsonTraits::compact_values>::type> : public std::true_type
+{
+};
+
 }
 
 #endif
@@ -18,6 +18,7 @@
 #include <fstream>
 #include <limits>
 #include <type_traits>
+#include <jsoncons/json_container.hpp>
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -575,12 +576,23 @@ struct json_type_traits<Json, T,
         bool result = rhs.is_array();
         if (result)
         {
-            for (auto e : rhs.array_range())
+            const auto& a = rhs.array_value();
+            if (a.packing() != array_packing::none)
             {
-                if (!e.template is<element_type>())
+                for (size_t i = 0; result && i < a.size(); ++i)
                 {
-                    result = false;
-                    break;
+                    result = packed_array_element<Json>(a, i).template is<element_type>();
+                }
+            }
+            else
+            {
+                for (auto e : rhs.array_range())
+                {
+                    if (!e.template is<element_type>())
+                    {
+                        result = false;
+                        break;
+                    }
                 }
             }
         }
@@ -591,6 +603,11 @@ struct json_type_traits<Json, T,
     {
         if (rhs.is_array())
         {
+            const auto& a = rhs.array_value();
+            if (a.packing() != array_packing::none)
+            {
+                return as_packed(a, std::integral_constant<bool,std::is_arithmetic<element_type>::value && !std::is_same<element_type,bool>::value>());
+            }
             T v(json_array_input_iterator<Json, element_type>(rhs.array_range().begin()),
                 json_array_input_iterator<Json, element_type>(rhs.array_range().end()));
             return v;
@@ -610,6 +627,31 @@ struct json_type_traits<Json, T,
     {
         return Json(std::begin(val), std::end(val), allocator);
     }
+private:
+    // Numbers are copied straight from a packed array, which for
+    // std::vector<double> from doubles is a memcpy
+
+    static T as_packed(const typename Json::array& a, std::true_type)
+    {
+        if (a.packing() == array_packing::doubles)
+        {
+            return T(a.packed_doubles(), a.packed_doubles() + a.size());
+        }
+        else
+        {
+            return T(a.packed_integers(), a.packed_integers() + a.size());
+        }
+    }
+
+    static T as_packed(const typename Json::array& a, std::false_type)
+    {
+        T v;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            v.insert(v.end(), packed_array_element<Json>(a, i).template as<element_type>());
+        }
+        return v;
+    }
 };
 
 template<class Json, typename T>
@@ -713,12 +755,23 @@ struct json_type_traits<Json, std::array<E, N>>
         bool result = rhs.is_array() && rhs.size() == N;
         if (result)
         {
-            for (auto e : rhs.array_range())
+            const auto& a = rhs.array_value();
+            if (a.packing() != array_packing::none)
+            {
+                for (size_t i = 0; result && i < N; ++i)
+                {
+                    result = packed_array_element<Json>(a, i).template is<element_type>();
+                }
+            }
+            else
             {
-                if (!e.template is<element_type>())
+                for (auto e : rhs.array_range())
                 {
-                    result = false;
-                    break;
+                    if (!e.template is<element_type>())
+                    {
+                        result = false;
+                        break;
+                    }
                 }
             }
         }
@@ -729,6 +782,15 @@ struct json_type_traits<Json, std::array<E, N>>
     {
         std::array<E, N> buff;
         JSONCONS_ASSERT(json.size() == N);
+        if (json.is_array() && json.array_value().packing() != array_packing::none)
+        {
+            const auto& a = json.array_value();
+            for (size_t i = 0; i < N; i++)
+            {
+                buff[i] = packed_array_element<Json>(a, i).template as<E>();
+            }
+            return buff;
+        }
         for (size_t i = 0; i < N; i++)
         {
             buff[i] = json[i].template as<E>();
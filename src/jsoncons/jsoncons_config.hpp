@@ -44,6 +44,32 @@ namespace jsoncons
 #define JSONCONS_HAS_STRTOD_L
 #endif
 
+// Uncomment the following line to disable the SSE2/AVX2 scanning fast paths
+//#define JSONCONS_NO_SIMD
+
+#if !defined(JSONCONS_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSONCONS_HAS_SSE2
+#endif
+#if defined(JSONCONS_HAS_SSE2)
+#if defined(__GNUC__) || defined(__clang__)
+#define JSONCONS_HAS_AVX2_DISPATCH
+#define JSONCONS_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && _MSC_VER >= 1900
+#define JSONCONS_HAS_AVX2_DISPATCH
+#define JSONCONS_TARGET_AVX2
+#endif
+#endif
+#endif
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define JSONCONS_BIG_ENDIAN
+#endif
+
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#define JSONCONS_HAS_POSIX_IO
+#endif
+
 #if defined (__clang__)
 #if defined(_GLIBCXX_USE_NOEXCEPT)
 #define JSONCONS_NOEXCEPT _GLIBCXX_USE_NOEXCEPT
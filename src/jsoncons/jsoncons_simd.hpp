@@ -0,0 +1,677 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSONCONS_SIMD_HPP
+#define JSONCONS_JSONCONS_SIMD_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/unicode_traits.hpp>
+
+#if defined(JSONCONS_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace jsoncons { namespace simd {
+
+// Scanning helpers used on hot paths of the parser. Each scanner has a
+// scalar version that works for any character type, an SSE2 version for
+// narrow characters, and an AVX2 version that is selected at runtime
+// when the processor supports it.
+
+inline
+unsigned trailing_zeros(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned n = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline
+bool cpu_has_avx2()
+{
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(info, 1);
+    // OSXSAVE and AVX
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+    {
+        return false;
+    }
+    // OS saves the YMM registers
+    if ((_xgetbv(0) & 6) != 6)
+    {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+#else
+    return false;
+#endif
+}
+
+// find_string_special
+
+// Returns a pointer to the first character in [p,end) that ends a run of
+// plain string content: a control character (< 0x20), a quotation mark or
+// a reverse solidus. Returns end if there is none. If any character before
+// the returned position is not ASCII, is_ascii is set to false.
+
+template <class CharT>
+const CharT* scalar_find_string_special(const CharT* p, const CharT* end, bool& is_ascii)
+{
+    typedef typename std::make_unsigned<CharT>::type uchar_type;
+    uchar_type high = 0;
+    for (; p < end; ++p)
+    {
+        uchar_type c = static_cast<uchar_type>(*p);
+        if (c < 0x20 || c == '\"' || c == '\\')
+        {
+            break;
+        }
+        high |= c;
+    }
+    if (high >= 0x80)
+    {
+        is_ascii = false;
+    }
+    return p;
+}
+
+#if defined(JSONCONS_HAS_SSE2)
+
+inline
+const char* sse2_find_string_special(const char* p, const char* end, bool& is_ascii)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i max_control = _mm_set1_epi8(0x1f);
+    __m128i high = _mm_setzero_si128();
+
+    while (end - p >= 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i is_control = _mm_cmpeq_epi8(_mm_max_epu8(v, max_control), max_control);
+        __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                 is_control);
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m));
+        if (mask != 0)
+        {
+            unsigned n = trailing_zeros(mask);
+            uint32_t high_mask = static_cast<uint32_t>(_mm_movemask_epi8(v));
+            if ((high_mask & ((1u << n) - 1)) != 0 || _mm_movemask_epi8(high) != 0)
+            {
+                is_ascii = false;
+            }
+            return p + n;
+        }
+        high = _mm_or_si128(high, v);
+        p += 16;
+    }
+    if (_mm_movemask_epi8(high) != 0)
+    {
+        is_ascii = false;
+    }
+    return scalar_find_string_special(p, end, is_ascii);
+}
+
+#endif
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+JSONCONS_TARGET_AVX2 inline
+const char* avx2_find_string_special(const char* p, const char* end, bool& is_ascii)
+{
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i max_control = _mm256_set1_epi8(0x1f);
+    __m256i high = _mm256_setzero_si256();
+
+    while (end - p >= 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i is_control = _mm256_cmpeq_epi8(_mm256_max_epu8(v, max_control), max_control);
+        __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                    is_control);
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+        if (mask != 0)
+        {
+            unsigned n = trailing_zeros(mask);
+            uint32_t high_mask = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+            if ((high_mask & ((1u << n) - 1)) != 0 || _mm256_movemask_epi8(high) != 0)
+            {
+                is_ascii = false;
+            }
+            return p + n;
+        }
+        high = _mm256_or_si256(high, v);
+        p += 32;
+    }
+    if (_mm256_movemask_epi8(high) != 0)
+    {
+        is_ascii = false;
+    }
+    return sse2_find_string_special(p, end, is_ascii);
+}
+
+#endif
+
+typedef const char* (*find_string_special_fn)(const char*, const char*, bool&);
+
+inline
+find_string_special_fn select_find_string_special()
+{
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+    if (cpu_has_avx2())
+    {
+        return avx2_find_string_special;
+    }
+#endif
+#if defined(JSONCONS_HAS_SSE2)
+    return sse2_find_string_special;
+#else
+    return scalar_find_string_special<char>;
+#endif
+}
+
+inline
+const char* find_string_special(const char* p, const char* end, bool& is_ascii)
+{
+    if (end - p < 16)
+    {
+        return scalar_find_string_special(p, end, is_ascii);
+    }
+    static const find_string_special_fn fn = select_find_string_special();
+    return fn(p, end, is_ascii);
+}
+
+template <class CharT>
+const CharT* find_string_special(const CharT* p, const CharT* end, bool& is_ascii)
+{
+    return scalar_find_string_special(p, end, is_ascii);
+}
+
+// find_newline
+
+// Returns a pointer to the first line feed in [p,end), or end if there is none.
+
+template <class CharT>
+const CharT* scalar_find_newline(const CharT* p, const CharT* end)
+{
+    while (p < end && *p != '\n')
+    {
+        ++p;
+    }
+    return p;
+}
+
+#if defined(JSONCONS_HAS_SSE2)
+
+inline
+const char* sse2_find_newline(const char* p, const char* end)
+{
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    while (end - p >= 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, lf)));
+        if (mask != 0)
+        {
+            return p + trailing_zeros(mask);
+        }
+        p += 16;
+    }
+    return scalar_find_newline(p, end);
+}
+
+#endif
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+JSONCONS_TARGET_AVX2 inline
+const char* avx2_find_newline(const char* p, const char* end)
+{
+    const __m256i lf = _mm256_set1_epi8('\n');
+
+    while (end - p >= 64)
+    {
+        __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        __m256i m1 = _mm256_cmpeq_epi8(v1, lf);
+        __m256i m2 = _mm256_cmpeq_epi8(v2, lf);
+        if (!_mm256_testz_si256(_mm256_or_si256(m1, m2), _mm256_or_si256(m1, m2)))
+        {
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(m1));
+            if (mask != 0)
+            {
+                return p + trailing_zeros(mask);
+            }
+            return p + 32 + trailing_zeros(static_cast<uint32_t>(_mm256_movemask_epi8(m2)));
+        }
+        p += 64;
+    }
+    return sse2_find_newline(p, end);
+}
+
+#endif
+
+typedef const char* (*find_newline_fn)(const char*, const char*);
+
+inline
+find_newline_fn select_find_newline()
+{
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+    if (cpu_has_avx2())
+    {
+        return avx2_find_newline;
+    }
+#endif
+#if defined(JSONCONS_HAS_SSE2)
+    return sse2_find_newline;
+#else
+    return scalar_find_newline<char>;
+#endif
+}
+
+inline
+const char* find_newline(const char* p, const char* end)
+{
+    if (end - p < 16)
+    {
+        return scalar_find_newline(p, end);
+    }
+    static const find_newline_fn fn = select_find_newline();
+    return fn(p, end);
+}
+
+template <class CharT>
+const CharT* find_newline(const CharT* p, const CharT* end)
+{
+    return scalar_find_newline(p, end);
+}
+
+// find_escape_special
+
+// Returns a pointer to the first character in [p,end) that escape_string
+// can't copy as is: a control character (< 0x20 or 0x7f), a quotation mark, a
+// reverse solidus, a solidus if escape_solidus is set, or a character that
+// is not ASCII if escape_non_ascii is set. Returns end if there is none.
+
+template <class CharT>
+const CharT* scalar_find_escape_special(const CharT* p, const CharT* end, bool escape_solidus, bool escape_non_ascii)
+{
+    typedef typename std::make_unsigned<CharT>::type uchar_type;
+    for (; p < end; ++p)
+    {
+        uchar_type c = static_cast<uchar_type>(*p);
+        if (c < 0x20 || c == 0x7f || c == '\"' || c == '\\' || (escape_solidus && c == '/') || (escape_non_ascii && c >= 0x80))
+        {
+            break;
+        }
+    }
+    return p;
+}
+
+#if defined(JSONCONS_HAS_SSE2)
+
+inline
+const char* sse2_find_escape_special(const char* p, const char* end, bool escape_solidus, bool escape_non_ascii)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    // Without escape_solidus this compares with the quotation mark again
+    const __m128i solidus = _mm_set1_epi8(escape_solidus ? '/' : '\"');
+    const __m128i max_control = _mm_set1_epi8(0x1f);
+    const __m128i del = _mm_set1_epi8(0x7f);
+    const int non_ascii_mask = escape_non_ascii ? 0xFFFF : 0;
+
+    while (end - p >= 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i is_control = _mm_or_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, max_control), max_control),
+                                          _mm_cmpeq_epi8(v, del));
+        __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                 _mm_or_si128(_mm_cmpeq_epi8(v, solidus), is_control));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m) | (_mm_movemask_epi8(v) & non_ascii_mask));
+        if (mask != 0)
+        {
+            return p + trailing_zeros(mask);
+        }
+        p += 16;
+    }
+    return scalar_find_escape_special(p, end, escape_solidus, escape_non_ascii);
+}
+
+#endif
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+JSONCONS_TARGET_AVX2 inline
+const char* avx2_find_escape_special(const char* p, const char* end, bool escape_solidus, bool escape_non_ascii)
+{
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i solidus = _mm256_set1_epi8(escape_solidus ? '/' : '\"');
+    const __m256i max_control = _mm256_set1_epi8(0x1f);
+    const __m256i del = _mm256_set1_epi8(0x7f);
+    const uint32_t non_ascii_mask = escape_non_ascii ? 0xFFFFFFFF : 0;
+
+    while (end - p >= 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i is_control = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, max_control), max_control),
+                                             _mm256_cmpeq_epi8(v, del));
+        __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                    _mm256_or_si256(_mm256_cmpeq_epi8(v, solidus), is_control));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(m)) | 
+                        (static_cast<uint32_t>(_mm256_movemask_epi8(v)) & non_ascii_mask);
+        if (mask != 0)
+        {
+            return p + trailing_zeros(mask);
+        }
+        p += 32;
+    }
+    return sse2_find_escape_special(p, end, escape_solidus, escape_non_ascii);
+}
+
+#endif
+
+typedef const char* (*find_escape_special_fn)(const char*, const char*, bool, bool);
+
+inline
+find_escape_special_fn select_find_escape_special()
+{
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+    if (cpu_has_avx2())
+    {
+        return avx2_find_escape_special;
+    }
+#endif
+#if defined(JSONCONS_HAS_SSE2)
+    return sse2_find_escape_special;
+#else
+    return scalar_find_escape_special<char>;
+#endif
+}
+
+inline
+const char* find_escape_special(const char* p, const char* end, bool escape_solidus, bool escape_non_ascii)
+{
+    if (end - p < 16)
+    {
+        return scalar_find_escape_special(p, end, escape_solidus, escape_non_ascii);
+    }
+    static const find_escape_special_fn fn = select_find_escape_special();
+    return fn(p, end, escape_solidus, escape_non_ascii);
+}
+
+template <class CharT>
+const CharT* find_escape_special(const CharT* p, const CharT* end, bool escape_solidus, bool escape_non_ascii)
+{
+    return scalar_find_escape_special(p, end, escape_solidus, escape_non_ascii);
+}
+
+// validate
+
+// Same contract as unicons::validate: returns conv_errc::ok and last, or the
+// error and the position of the offending sequence. Blocks of ASCII are
+// skipped in bulk. With AVX2 the whole input is checked with the lookup
+// table algorithm of Keiser and Lemire, "Validating UTF-8 In Less Than One
+// Instruction Per Byte", and unicons::validate is only used to report the
+// error, or to check the last few bytes.
+
+template <class CharT>
+std::pair<unicons::conv_errc,const CharT*> scalar_validate(const CharT* first, const CharT* last)
+{
+    return unicons::validate(first, last);
+}
+
+#if defined(JSONCONS_HAS_SSE2)
+
+inline
+std::pair<unicons::conv_errc,const char*> sse2_validate(const char* first, const char* last)
+{
+    while (first < last)
+    {
+        if (last - first >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(v));
+            if (mask == 0)
+            {
+                first += 16;
+                continue;
+            }
+            first += trailing_zeros(mask);
+        }
+        size_t length = unicons::trailing_bytes_for_utf8[static_cast<uint8_t>(*first)] + 1;
+        if (length > static_cast<size_t>(last - first))
+        {
+            return std::make_pair(unicons::conv_errc::source_exhausted,first);
+        }
+        unicons::conv_errc result = unicons::is_legal_utf8(first, length);
+        if (result != unicons::conv_errc::ok)
+        {
+            return std::make_pair(result,first);
+        }
+        first += length;
+    }
+    return std::make_pair(unicons::conv_errc::ok,first);
+}
+
+#endif
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+JSONCONS_TARGET_AVX2 inline
+__m256i avx2_utf8_prev(__m256i input, __m256i prev_input, int n)
+{
+    // Shift input right by n bytes across the 128-bit lanes, shifting in
+    // the last n bytes of prev_input
+    __m256i t = _mm256_permute2x128_si256(prev_input, input, 0x21);
+    switch (n)
+    {
+    case 1:
+        return _mm256_alignr_epi8(input, t, 16 - 1);
+    case 2:
+        return _mm256_alignr_epi8(input, t, 16 - 2);
+    default:
+        return _mm256_alignr_epi8(input, t, 16 - 3);
+    }
+}
+
+JSONCONS_TARGET_AVX2 inline
+__m256i avx2_utf8_errors(__m256i input, __m256i prev_input)
+{
+    const uint8_t too_short = 1 << 0;   // 11______ 0_______ or 11______ 11______
+    const uint8_t too_long = 1 << 1;    // 0_______ 10______
+    const uint8_t overlong_3 = 1 << 2;  // 11100000 100_____
+    const uint8_t too_large = 1 << 3;   // 11110100 1001____ and above
+    const uint8_t surrogate = 1 << 4;   // 11101101 101_____
+    const uint8_t overlong_2 = 1 << 5;  // 1100000_ 10______
+    const uint8_t too_large_1000 = 1 << 6; // 11110101 1000____ and above
+    const uint8_t overlong_4 = 1 << 6;  // 11110000 1000____
+    const uint8_t two_conts = 1 << 7;   // 10______ 10______
+    const uint8_t carry = too_short | too_long | two_conts;
+
+    const __m256i byte_1_high_table = _mm256_setr_epi8(
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2, too_short, too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4,
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        two_conts, two_conts, two_conts, two_conts,
+        too_short | overlong_2, too_short, too_short | overlong_3 | surrogate,
+        too_short | too_large | too_large_1000 | overlong_4);
+
+    const __m256i byte_1_low_table = _mm256_setr_epi8(
+        carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry,
+        carry | too_large, carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000 | surrogate, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | overlong_3 | overlong_2 | overlong_4, carry | overlong_2, carry, carry,
+        carry | too_large, carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000, carry | too_large | too_large_1000 | surrogate, carry | too_large | too_large_1000, carry | too_large | too_large_1000);
+
+    const __m256i byte_2_high_table = _mm256_setr_epi8(
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_short, too_short, too_short, too_short,
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+        too_long | overlong_2 | two_conts | overlong_3 | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_long | overlong_2 | two_conts | surrogate | too_large,
+        too_short, too_short, too_short, too_short);
+
+    const __m256i low_nibble = _mm256_set1_epi8(0x0f);
+
+    __m256i prev1 = avx2_utf8_prev(input, prev_input, 1);
+    __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+    __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, low_nibble));
+    __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+    __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // Third and fourth bytes of a sequence must be continuation bytes
+    __m256i prev2 = avx2_utf8_prev(input, prev_input, 2);
+    __m256i prev3 = avx2_utf8_prev(input, prev_input, 3);
+    __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+    __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+    __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), 
+                                                    _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+JSONCONS_TARGET_AVX2 inline
+std::pair<unicons::conv_errc,const char*> avx2_validate(const char* first, const char* last)
+{
+    // Bytes greater than these at the end of a block start a sequence that 
+    // continues into the next block
+    const __m256i incomplete_max = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 
+        static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1), static_cast<char>(0xc0 - 1));
+
+    const char* p = first;
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+
+    while (last - p >= 32)
+    {
+        __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            error = _mm256_or_si256(error, prev_incomplete);
+            prev_incomplete = _mm256_setzero_si256();
+        }
+        else
+        {
+            error = _mm256_or_si256(error, avx2_utf8_errors(input, prev_input));
+            prev_incomplete = _mm256_subs_epu8(input, incomplete_max);
+        }
+        prev_input = input;
+        p += 32;
+    }
+
+    if (!_mm256_testz_si256(error, error))
+    {
+        return sse2_validate(first, last);
+    }
+
+    // Back up to the start of a sequence that may continue past p
+    const char* q = p;
+    while (q > first && p - q < 3 && (static_cast<uint8_t>(*(q-1)) & 0xc0) == 0x80)
+    {
+        --q;
+    }
+    if (q > first && static_cast<uint8_t>(*(q-1)) >= 0xc0)
+    {
+        --q;
+    }
+    else
+    {
+        q = p;
+    }
+    return sse2_validate(q, last);
+}
+
+#endif
+
+typedef std::pair<unicons::conv_errc,const char*> (*validate_fn)(const char*, const char*);
+
+inline
+validate_fn select_validate()
+{
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+    if (cpu_has_avx2())
+    {
+        return avx2_validate;
+    }
+#endif
+#if defined(JSONCONS_HAS_SSE2)
+    return sse2_validate;
+#else
+    return scalar_validate<char>;
+#endif
+}
+
+inline
+std::pair<unicons::conv_errc,const char*> validate(const char* first, const char* last)
+{
+    if (last - first < 16)
+    {
+        return unicons::validate(first, last);
+    }
+    static const validate_fn fn = select_validate();
+    return fn(first, last);
+}
+
+template <class CharT>
+std::pair<unicons::conv_errc,const CharT*> validate(const CharT* first, const CharT* last)
+{
+    return scalar_validate(first, last);
+}
+
+}}
+
+#endif
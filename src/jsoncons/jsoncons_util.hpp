@@ -22,6 +22,8 @@
 #include <type_traits>
 #include <jsoncons/jsoncons_config.hpp>
 #include <jsoncons/osequencestream.hpp>
+#include <jsoncons/decimal_to_double.hpp>
+#include <jsoncons/double_to_decimal.hpp>
 #include <algorithm>
 #include <memory>
 #include <iterator>
@@ -95,6 +97,19 @@ T * to_plain_pointer(T * ptr)
     return (ptr);
 }  
 
+// FNV-1a hash of the characters of a string
+
+template <class CharT> inline
+size_t hash_string(const CharT* s, size_t length)
+{
+    size_t h = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        h = (h ^ static_cast<size_t>(s[i])) * 16777619u;
+    }
+    return h;
+}
+
 #if !defined(JSONCONS_HAS_STRING_VIEW)
 template <class CharT, class Traits = std::char_traits<CharT>>
 class Basic_string_view_
@@ -648,9 +663,17 @@ struct cstring_traits<wchar_t>
 #endif
 };
 
+// The sink that serializers write to by default. A sink has put, write
+// and flush, and an output_type that it is constructed from, see
+// output_sinks.hpp for the others.
+
 template <class CharT>
 class buffered_output
 {
+public:
+    typedef CharT char_type;
+    typedef std::basic_ostream<CharT>& output_type;
+private:
     static const size_t default_buffer_length = 16384;
 
     std::basic_ostream<CharT>& os_;
@@ -733,13 +756,18 @@ public:
     {
     }
 
-    void operator()(double val, uint8_t precision, buffered_output<CharT>& os) 
+    template <class Sink>
+    void operator()(double val, uint8_t precision, Sink& os) 
     {
         char buf[_CVTBUFSIZE];
         int decimal_point = 0;
         int sign = 0;
 
         int prec = (precision == 0) ? precision_ : precision;
+        if (prec == 0)
+        {
+            prec = std::numeric_limits<double>::max_digits10;
+        }
 
         int err = _ecvt_s(buf, _CVTBUFSIZE, val, prec, &decimal_point, &sign);
         if (err != 0)
@@ -843,10 +871,17 @@ public:
         oss_.imbue(std::locale::classic());
         oss_.precision(precision);
     }
-    void operator()(double val, uint8_t precision, buffered_output<CharT>& os)
+    template <class Sink>
+    void operator()(double val, uint8_t precision, Sink& os)
     {
+        const int prec = (precision == 0) ? precision_ : precision;
+        if (prec <= std::numeric_limits<double>::digits10 && print_decimal(val, prec, os))
+        {
+            return;
+        }
+
         oss_.clear_sequence();
-        oss_.precision((precision == 0) ? precision_ : precision);
+        oss_.precision(prec);
         oss_ << val;
 
         const CharT* sbeg = oss_.data();
@@ -911,6 +946,114 @@ public:
             }
         }
     }
+private:
+    // Writes the same text as the stream would, but from the digits of
+    // double_to_decimal. That is possible for a normal double when they
+    // number no more than a precision of at most 15, because then the
+    // stream rounds to them.
+    // A precision of 0 asks for those digits whatever their number.
+
+    template <class Sink>
+    bool print_decimal(double val, int prec, Sink& os)
+    {
+        char digits[18];
+        int length = 1;
+        int exponent = 0;
+        if (val == 0)
+        {
+            digits[0] = '0';
+        }
+        else
+        {
+            const double magnitude = val < 0 ? -val : val;
+            // Subnormals have fewer bits, so the stream may round them
+            // differently
+            if (prec != 0 && magnitude < (std::numeric_limits<double>::min)())
+            {
+                return false;
+            }
+            double_to_decimal(magnitude, digits, length, exponent);
+            if (prec != 0 && length > prec)
+            {
+                return false;
+            }
+        }
+
+        CharT buf[32];
+        CharT* p = buf;
+        if ((std::signbit)(val))
+        {
+            *p++ = '-';
+        }
+
+        // The exponent of the first digit, which with the precision decides
+        // between fixed and scientific notation as %g does
+        const int x = length + exponent - 1;
+        const int max_fixed_exponent = prec == 0 ? std::numeric_limits<double>::digits10 : prec;
+
+        if (x < -4 || x >= max_fixed_exponent)
+        {
+            *p++ = digits[0];
+            *p++ = '.';
+            if (length == 1)
+            {
+                *p++ = '0';
+            }
+            for (int i = 1; i < length; ++i)
+            {
+                *p++ = digits[i];
+            }
+            *p++ = 'e';
+            *p++ = x < 0 ? '-' : '+';
+            int e = x < 0 ? -x : x;
+            if (e >= 100)
+            {
+                *p++ = static_cast<CharT>('0' + e / 100);
+                e %= 100;
+            }
+            *p++ = static_cast<CharT>('0' + e / 10);
+            *p++ = static_cast<CharT>('0' + e % 10);
+        }
+        else if (x < 0)
+        {
+            *p++ = '0';
+            *p++ = '.';
+            for (int i = -1; i > x; --i)
+            {
+                *p++ = '0';
+            }
+            for (int i = 0; i < length; ++i)
+            {
+                *p++ = digits[i];
+            }
+        }
+        else if (length <= x + 1)
+        {
+            for (int i = 0; i < length; ++i)
+            {
+                *p++ = digits[i];
+            }
+            for (int i = length; i <= x; ++i)
+            {
+                *p++ = '0';
+            }
+            *p++ = '.';
+            *p++ = '0';
+        }
+        else
+        {
+            for (int i = 0; i < length; ++i)
+            {
+                if (i == x + 1)
+                {
+                    *p++ = '.';
+                }
+                *p++ = digits[i];
+            }
+        }
+        os.write(buf, p - buf);
+        return true;
+    }
 };
 #endif
 
@@ -933,9 +1076,14 @@ public:
 
     double operator()(const CharT* s, size_t)
     {
+        double val;
+        if (try_decimal_to_double(s, val))
+        {
+            return val;
+        }
         const CharT *begin = s;
         CharT *end = nullptr;
-        double val = cstring_traits<CharT>::_tod_l(begin, &end, locale_);
+        val = cstring_traits<CharT>::_tod_l(begin, &end, locale_);
         if (begin == end)
         {
             throw std::invalid_argument("Invalid float value");
@@ -965,11 +1113,16 @@ public:
         freelocale(locale_);
     }
 
-    double operator()(const CharT* s, size_t length)
+    double operator()(const CharT* s, size_t)
     {
+        double val;
+        if (try_decimal_to_double(s, val))
+        {
+            return val;
+        }
         const CharT *begin = s;
         CharT *end = nullptr;
-        double val = cstring_traits<CharT>::tod_l(begin, &end, locale_);
+        val = cstring_traits<CharT>::tod_l(begin, &end, locale_);
         if (begin == end)
         {
             throw std::invalid_argument("Invalid float value");
@@ -1011,6 +1164,10 @@ public:
     double operator()(const CharT* s, size_t length)
     {
         double val;
+        if (try_decimal_to_double(s, val))
+        {
+            return val;
+        }
         if (is_dot_)
         {
             const CharT *begin = s;
@@ -0,0 +1,545 @@
+// Copyright 2017 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_OUTPUT_SINKS_HPP
+#define JSONCONS_OUTPUT_SINKS_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <jsoncons/jsoncons_config.hpp>
+#include <jsoncons/jsoncons.hpp>
+
+#if defined(JSONCONS_HAS_POSIX_IO)
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+namespace jsoncons {
+
+// Sinks for basic_json_serializer and basic_csv_serializer other than the
+// default buffered_output, which writes to a std::basic_ostream.
+//
+// A sink has a char_type, an output_type that it is constructed from, and
+//
+//     void put(char_type ch);
+//     void write(const char_type* s, size_t length);
+//     void flush();
+//
+// A serializer owns its sink, so a sink reports its results through the
+// object it was constructed from.
+
+// string_sink
+
+// Appends to a string, writing into its storage. The string is grown ahead
+// of the text, and cut back to it by flush and by the destructor.
+
+template <class StringT>
+class string_sink
+{
+public:
+    typedef typename StringT::value_type char_type;
+    typedef StringT& output_type;
+private:
+    static const size_t min_grow_length = 256;
+
+    StringT& s_;
+    char_type* p_;
+    char_type* end_buffer_;
+
+    // Noncopyable and nonmoveable
+    string_sink(const string_sink&) = delete;
+    string_sink& operator=(const string_sink&) = delete;
+public:
+    string_sink(output_type s)
+        : s_(s), p_(nullptr), end_buffer_(nullptr)
+    {
+        size_t length = s_.size();
+        reset(length);
+    }
+
+    ~string_sink()
+    {
+        s_.resize(p_ - &s_[0]);
+    }
+
+    void flush()
+    {
+        size_t length = p_ - &s_[0];
+        s_.resize(length);
+        reset(length);
+    }
+
+    void write(const char_type* s, size_t length)
+    {
+        if (static_cast<size_t>(end_buffer_ - p_) < length)
+        {
+            grow(length);
+        }
+        std::char_traits<char_type>::copy(p_, s, length);
+        p_ += length;
+    }
+
+    void put(char_type ch)
+    {
+        if (p_ == end_buffer_)
+        {
+            grow(1);
+        }
+        *p_++ = ch;
+    }
+private:
+    void grow(size_t n)
+    {
+        size_t length = p_ - &s_[0];
+        size_t new_size;
+        if (s_.capacity() >= length + n)
+        {
+            // Use the capacity that the caller reserved before reallocating
+            new_size = s_.capacity();
+        }
+        else
+        {
+            new_size = s_.size() * 2;
+            if (new_size < length + n)
+            {
+                new_size = length + n;
+            }
+            if (new_size < min_grow_length)
+            {
+                new_size = min_grow_length;
+            }
+        }
+        s_.resize(new_size);
+        reset(length);
+    }
+
+    void reset(size_t length)
+    {
+        p_ = &s_[0] + length;
+        end_buffer_ = &s_[0] + s_.size();
+    }
+};
+
+// fixed_buffer_sink
+
+// A caller owned array for a fixed_buffer_sink. Text that doesn't fit is
+// dropped, and required_size() is the length the whole text would need.
+
+template <class CharT>
+class basic_fixed_buffer
+{
+    template <class C>
+    friend class fixed_buffer_sink;
+
+    CharT* data_;
+    size_t capacity_;
+    size_t length_;
+public:
+    basic_fixed_buffer(CharT* data, size_t capacity)
+        : data_(data), capacity_(capacity), length_(0)
+    {
+    }
+
+    const CharT* data() const
+    {
+        return data_;
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    size_t size() const
+    {
+        return length_ < capacity_ ? length_ : capacity_;
+    }
+
+    size_t required_size() const
+    {
+        return length_;
+    }
+
+    bool overflow() const
+    {
+        return length_ > capacity_;
+    }
+
+    void clear()
+    {
+        length_ = 0;
+    }
+};
+
+typedef basic_fixed_buffer<char> fixed_buffer;
+typedef basic_fixed_buffer<wchar_t> wfixed_buffer;
+
+template <class CharT>
+class fixed_buffer_sink
+{
+public:
+    typedef CharT char_type;
+    typedef basic_fixed_buffer<CharT>& output_type;
+private:
+    basic_fixed_buffer<CharT>& buffer_;
+
+    // Noncopyable and nonmoveable
+    fixed_buffer_sink(const fixed_buffer_sink&) = delete;
+    fixed_buffer_sink& operator=(const fixed_buffer_sink&) = delete;
+public:
+    fixed_buffer_sink(output_type buffer)
+        : buffer_(buffer)
+    {
+    }
+
+    void flush()
+    {
+    }
+
+    void write(const CharT* s, size_t length)
+    {
+        if (buffer_.length_ < buffer_.capacity_)
+        {
+            size_t n = buffer_.capacity_ - buffer_.length_;
+            std::memcpy(buffer_.data_ + buffer_.length_, s, (length < n ? length : n)*sizeof(CharT));
+        }
+        buffer_.length_ += length;
+    }
+
+    void put(CharT ch)
+    {
+        if (buffer_.length_ < buffer_.capacity_)
+        {
+            buffer_.data_[buffer_.length_] = ch;
+        }
+        ++buffer_.length_;
+    }
+};
+
+// counting_sink
+
+// Counts the characters written, for measuring output without storing it
+
+template <class CharT>
+class counting_sink
+{
+public:
+    typedef CharT char_type;
+    typedef size_t& output_type;
+private:
+    size_t& count_;
+
+    // Noncopyable and nonmoveable
+    counting_sink(const counting_sink&) = delete;
+    counting_sink& operator=(const counting_sink&) = delete;
+public:
+    counting_sink(output_type count)
+        : count_(count)
+    {
+    }
+
+    void flush()
+    {
+    }
+
+    void write(const CharT*, size_t length)
+    {
+        count_ += length;
+    }
+
+    void put(CharT)
+    {
+        ++count_;
+    }
+};
+
+#if defined(JSONCONS_HAS_POSIX_IO)
+
+// fd_sink
+
+// Writes to a POSIX file descriptor through a large buffer. flush throws
+// std::runtime_error if a write fails; the destructor writes what is left
+// and ignores errors.
+
+class fd_sink
+{
+public:
+    typedef char char_type;
+    typedef int output_type;
+    static const size_t default_buffer_length = 65536;
+private:
+    int fd_;
+    std::vector<char> buffer_;
+    char* const begin_buffer_;
+    const char* const end_buffer_;
+    char* p_;
+
+    // Noncopyable and nonmoveable
+    fd_sink(const fd_sink&) = delete;
+    fd_sink& operator=(const fd_sink&) = delete;
+public:
+    fd_sink(output_type fd, size_t buffer_length = default_buffer_length)
+        : fd_(fd), buffer_(buffer_length > 0 ? buffer_length : 1),
+          begin_buffer_(buffer_.data()), end_buffer_(buffer_.data()+buffer_.size()), p_(buffer_.data())
+    {
+    }
+
+    ~fd_sink()
+    {
+        write_all(begin_buffer_, p_ - begin_buffer_);
+    }
+
+    void flush()
+    {
+        size_t length = p_ - begin_buffer_;
+        p_ = begin_buffer_;
+        if (!write_all(begin_buffer_, length))
+        {
+            JSONCONS_THROW_EXCEPTION(std::runtime_error,"Failed writing to file descriptor");
+        }
+    }
+
+    void write(const char* s, size_t length)
+    {
+        if (static_cast<size_t>(end_buffer_ - p_) >= length)
+        {
+            std::memcpy(p_, s, length);
+            p_ += length;
+        }
+        else
+        {
+            flush();
+            if (length >= buffer_.size())
+            {
+                if (!write_all(s, length))
+                {
+                    JSONCONS_THROW_EXCEPTION(std::runtime_error,"Failed writing to file descriptor");
+                }
+            }
+            else
+            {
+                std::memcpy(p_, s, length);
+                p_ += length;
+            }
+        }
+    }
+
+    void put(char ch)
+    {
+        if (p_ == end_buffer_)
+        {
+            flush();
+        }
+        *p_++ = ch;
+    }
+private:
+    bool write_all(const char* s, size_t length)
+    {
+        while (length > 0)
+        {
+            ssize_t n = ::write(fd_, s, length);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+            s += n;
+            length -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+};
+
+// iovec_sink
+
+// A caller owned sequence of blocks for an iovec_sink. A block is never
+// moved once written, so the whole text can be handed to writev, or to any
+// API that takes a batch of buffers, without copying it into one.
+
+class iovec_buffer
+{
+    friend class iovec_sink;
+
+    struct block
+    {
+        std::unique_ptr<char[]> data;
+        size_t length;
+    };
+
+    size_t block_length_;
+    std::vector<block> blocks_;
+    size_t size_;
+
+    // Noncopyable
+    iovec_buffer(const iovec_buffer&) = delete;
+    iovec_buffer& operator=(const iovec_buffer&) = delete;
+public:
+    static const size_t default_block_length = 65536;
+
+    iovec_buffer(size_t block_length = default_block_length)
+        : block_length_(block_length > 0 ? block_length : 1), size_(0)
+    {
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    std::vector<struct iovec> iovecs() const
+    {
+        std::vector<struct iovec> v;
+        v.reserve(blocks_.size());
+        for (const auto& b : blocks_)
+        {
+            if (b.length > 0)
+            {
+                struct iovec iov;
+                iov.iov_base = b.data.get();
+                iov.iov_len = b.length;
+                v.push_back(iov);
+            }
+        }
+        return v;
+    }
+
+    // Writes all of the blocks to fd, IOV_MAX at a time, and throws
+    // std::runtime_error if a write fails
+
+    void write_to(int fd) const
+    {
+#if defined(IOV_MAX)
+        const size_t max_count = IOV_MAX;
+#else
+        const size_t max_count = 16; // The least that POSIX allows
+#endif
+        std::vector<struct iovec> v = iovecs();
+        size_t first = 0;
+        while (first < v.size())
+        {
+            int count = static_cast<int>((v.size() - first) < max_count ? (v.size() - first) : max_count);
+            ssize_t n = ::writev(fd, &v[first], count);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                JSONCONS_THROW_EXCEPTION(std::runtime_error,"Failed writing to file descriptor");
+            }
+            // Skip what was written, which may end part way into a block
+            size_t written = static_cast<size_t>(n);
+            while (first < v.size() && written >= v[first].iov_len)
+            {
+                written -= v[first].iov_len;
+                ++first;
+            }
+            if (written > 0)
+            {
+                v[first].iov_base = static_cast<char*>(v[first].iov_base) + written;
+                v[first].iov_len -= written;
+            }
+        }
+    }
+
+    void clear()
+    {
+        blocks_.clear();
+        size_ = 0;
+    }
+};
+
+class iovec_sink
+{
+public:
+    typedef char char_type;
+    typedef iovec_buffer& output_type;
+private:
+    iovec_buffer& buffer_;
+    char* p_;
+    char* end_buffer_;
+
+    // Noncopyable and nonmoveable
+    iovec_sink(const iovec_sink&) = delete;
+    iovec_sink& operator=(const iovec_sink&) = delete;
+public:
+    iovec_sink(output_type buffer)
+        : buffer_(buffer), p_(nullptr), end_buffer_(nullptr)
+    {
+    }
+
+    ~iovec_sink()
+    {
+        flush();
+    }
+
+    void flush()
+    {
+        // The last block is this sink's once it has started one
+        if (p_ != nullptr)
+        {
+            iovec_buffer::block& b = buffer_.blocks_.back();
+            size_t length = p_ - b.data.get();
+            buffer_.size_ += length - b.length;
+            b.length = length;
+        }
+    }
+
+    void write(const char* s, size_t length)
+    {
+        while (length > 0)
+        {
+            if (p_ == end_buffer_)
+            {
+                new_block();
+            }
+            size_t n = end_buffer_ - p_;
+            if (length < n)
+            {
+                n = length;
+            }
+            std::memcpy(p_, s, n);
+            p_ += n;
+            s += n;
+            length -= n;
+        }
+    }
+
+    void put(char ch)
+    {
+        if (p_ == end_buffer_)
+        {
+            new_block();
+        }
+        *p_++ = ch;
+    }
+private:
+    void new_block()
+    {
+        flush();
+        iovec_buffer::block b;
+        b.data.reset(new char[buffer_.block_length_]);
+        b.length = 0;
+        buffer_.blocks_.push_back(std::move(b));
+        p_ = buffer_.blocks_.back().data.get();
+        end_buffer_ = p_ + buffer_.block_length_;
+    }
+};
+
+#endif
+
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include <cwchar>
 #include <jsoncons/jsoncons.hpp>
 #include <jsoncons/jsoncons_util.hpp>
+#include <jsoncons/jsoncons_simd.hpp>
 
 namespace jsoncons {
 
@@ -24,9 +25,6 @@ namespace jsoncons {
 enum class block_options {next_line,same_line};
 #endif
 
-template <class CharT>
-class buffered_output;
-
 enum class line_split_kind{same_line,new_line,multi_line};
 
 template <class CharT>
@@ -55,7 +53,7 @@ public:
     basic_serialization_options()
         :
         indent_(default_indent),
-        precision_(std::numeric_limits<double>::digits10),
+        precision_(0),
         replace_nan_(true),
         replace_pos_inf_(true),
         replace_neg_inf_(true),
@@ -239,16 +237,30 @@ public:
     }
 };
 
-template<class CharT>
+template<class CharT,class Sink>
 void escape_string(const CharT* s,
                    size_t length,
                    const basic_serialization_options<CharT>& options,
-                   buffered_output<CharT>& os)
+                   Sink& os)
 {
     const CharT* begin = s;
     const CharT* end = s + length;
+    const bool escape_solidus = options.escape_solidus();
+    const bool escape_all_non_ascii = options.escape_all_non_ascii();
     for (const CharT* it = begin; it != end; ++it)
     {
+        // Copy the run of characters that need no escaping in one write
+        const CharT* run_end = simd::find_escape_special(it, end, escape_solidus, escape_all_non_ascii);
+        if (run_end != it)
+        {
+            os.write(it, run_end - it);
+            it = run_end;
+            if (it == end)
+            {
+                break;
+            }
+        }
+
         CharT c = *it;
         switch (c)
         {
@@ -281,12 +293,12 @@ void escape_string(const CharT* s,
             os.put('t');
             break;
         default:
-            if (options.escape_solidus() && c == '/')
+            if (escape_solidus && c == '/')
             {
                 os.put('\\');
                 os.put('/');
             }
-            else if (is_control_character(c) || options.escape_all_non_ascii())
+            else if (is_control_character(c) || escape_all_non_ascii)
             {
                 // convert utf8 to codepoint
                 unicons::sequence_generator<const CharT*> g(it,end,unicons::conv_flags::strict);
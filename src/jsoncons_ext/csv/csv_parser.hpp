@@ -841,7 +841,7 @@ private:
         stack_[top_] = mode;
     }
 
-    int peek()
+    csv_mode_type peek()
     {
         return stack_[top_];
     }
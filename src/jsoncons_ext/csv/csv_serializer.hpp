@@ -17,15 +17,16 @@
 #include <jsoncons/jsoncons.hpp>
 #include <jsoncons/serialization_options.hpp>
 #include <jsoncons/json_output_handler.hpp>
+#include <jsoncons/output_sinks.hpp>
 #include <jsoncons_ext/csv/csv_parameters.hpp>
 
 namespace jsoncons { namespace csv {
 
-template <class CharT>
+template <class CharT,class Sink>
 void escape_string(const CharT* s,
                    size_t length,
                    CharT quote_char, CharT quote_escape_char,
-                   buffered_output<CharT>& os)
+                   Sink& os)
 {
     const CharT* begin = s;
     const CharT* end = s + length;
@@ -44,11 +45,14 @@ void escape_string(const CharT* s,
     }
 }
 
-template<class CharT>
+template<class CharT,class Sink=buffered_output<CharT>>
 class basic_csv_serializer : public basic_json_output_handler<CharT>
 {
+    static_assert(std::is_same<CharT,typename Sink::char_type>::value, "Sink must write CharT");
 public:
     using typename basic_json_output_handler<CharT>::string_view_type                                 ;
+    typedef Sink sink_type;
+    typedef typename Sink::output_type output_type;
 private:
     struct stack_item
     {
@@ -65,12 +69,12 @@ private:
         size_t count_;
         bool skip_;
     };
-    buffered_output<CharT> os_;
+    Sink os_;
     basic_csv_parameters<CharT> parameters_;
     basic_serialization_options<CharT> format_;
     std::vector<stack_item> stack_;
-    std::basic_ostringstream<CharT> header_oss_;
-    buffered_output<CharT> header_os_;
+    std::basic_string<CharT> header_;
+    string_sink<std::basic_string<CharT>> header_os_;
     std::map<std::basic_string<CharT>,size_t> column_name_pos_map_;
     print_double<CharT> fp_;
 
@@ -78,25 +82,25 @@ private:
     basic_csv_serializer(const basic_csv_serializer&) = delete;
     basic_csv_serializer& operator=(const basic_csv_serializer&) = delete;
 public:
-    basic_csv_serializer(std::basic_ostream<CharT>& os)
+    basic_csv_serializer(output_type os)
        :
        os_(os),
        format_(),
        stack_(),
-       header_os_(header_oss_),
+       header_os_(header_),
        column_name_pos_map_(),
        fp_(format_.precision())
     {
     }
 
-    basic_csv_serializer(std::basic_ostream<CharT>& os,
+    basic_csv_serializer(output_type os,
                          basic_csv_parameters<CharT> params)
        :
        os_(os),
        parameters_(params),
        format_(),
        stack_(),
-       header_os_(header_oss_),
+       header_os_(header_),
        column_name_pos_map_(),
        fp_(format_.precision())
     {
@@ -129,7 +133,7 @@ private:
                 }
                 write_string(name.data(), name.length(),os_);
             }
-            os_.write(parameters_.line_delimiter());
+            write_line_delimiter();
         }
     }
 
@@ -152,11 +156,11 @@ private:
                 os_.put(parameters_.field_delimiter());
                 ++stack_.back().count_;
             }
-            os_.write(parameters_.line_delimiter());
+            write_line_delimiter();
             if (stack_[0].count_ == 0)
             {
                 header_os_.flush();
-                os_.write(header_oss_.str());
+                os_.write(header_.data(),header_.length());
             }
         }
         stack_.pop_back();
@@ -173,7 +177,7 @@ private:
     {
         if (stack_.size() == 2)
         {
-            os_.write(parameters_.line_delimiter());
+            write_line_delimiter();
         }
         stack_.pop_back();
 
@@ -213,7 +217,14 @@ private:
         }
     }
 
-    void write_string(const CharT* s, size_t length, buffered_output<CharT>& os)
+    void write_line_delimiter()
+    {
+        auto delimiter = parameters_.line_delimiter();
+        os_.write(delimiter.data(),delimiter.length());
+    }
+
+    template <class SinkT>
+    void write_string(const CharT* s, size_t length, SinkT& os)
     {
         bool quote = false;
         if (parameters_.quote_style() == quote_style_type::all || parameters_.quote_style() == quote_style_type::nonnumeric ||
@@ -323,28 +334,33 @@ private:
         }
     }
 
-    void value(string_view_type value, buffered_output<CharT>& os)
+    template <class SinkT>
+    void value(string_view_type value, SinkT& os)
     {
         begin_value(os);
         write_string(value.data(),value.length(),os);
         end_value();
     }
 
-    void value(double val, buffered_output<CharT>& os)
+    template <class SinkT>
+    void value(double val, SinkT& os)
     {
         begin_value(os);
 
         if ((std::isnan)(val))
         {
-            os.write(format_.nan_replacement());
+            auto s = format_.nan_replacement();
+            os.write(s.data(),s.length());
         }
         else if (val == std::numeric_limits<double>::infinity())
         {
-            os.write(format_.pos_inf_replacement());
+            auto s = format_.pos_inf_replacement();
+            os.write(s.data(),s.length());
         }
         else if (!(std::isfinite)(val))
         {
-            os.write(format_.neg_inf_replacement());
+            auto s = format_.neg_inf_replacement();
+            os.write(s.data(),s.length());
         }
         else
         {
@@ -355,29 +371,28 @@ private:
 
     }
 
-    void value(int64_t val, buffered_output<CharT>& os)
+    template <class SinkT>
+    void value(int64_t val, SinkT& os)
     {
         begin_value(os);
 
-        std::basic_ostringstream<CharT> ss;
-        ss << val;
-        os.write(ss.str());
+        print_integer(val,os);
 
         end_value();
     }
 
-    void value(uint64_t val, buffered_output<CharT>& os)
+    template <class SinkT>
+    void value(uint64_t val, SinkT& os)
     {
         begin_value(os);
 
-        std::basic_ostringstream<CharT> ss;
-        ss << val;
-        os.write(ss.str());
+        print_uinteger(val,os);
 
         end_value();
     }
 
-    void value(bool val, buffered_output<CharT>& os) 
+    template <class SinkT>
+    void value(bool val, SinkT& os) 
     {
         begin_value(os);
 
@@ -395,7 +410,8 @@ private:
         end_value();
     }
 
-    void do_null_value(buffered_output<CharT>& os) 
+    template <class SinkT>
+    void do_null_value(SinkT& os) 
     {
         begin_value(os);
         auto buf = json_literals<CharT>::null_literal();
@@ -404,7 +420,8 @@ private:
 
     }
 
-    void begin_value(buffered_output<CharT>& os)
+    template <class SinkT>
+    void begin_value(SinkT& os)
     {
         if (!stack_.empty())
         {
@@ -0,0 +1,114 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/arena_allocator.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <ctime>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(arena_allocator_tests)
+
+typedef basic_json<char,json_traits<char>,arena_allocator<char>> arena_json;
+typedef basic_json<char,o_json_traits<char>,arena_allocator<char>> arena_ojson;
+
+template <class Json>
+std::string to_string(const Json& j)
+{
+    std::string s;
+    j.dump(s);
+    return s;
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_allocate)
+{
+    arena a(1024);
+    BOOST_CHECK_EQUAL(0, a.capacity());
+
+    void* p1 = a.allocate(10, 1);
+    void* p2 = a.allocate(8, 8);
+    BOOST_CHECK(p1 != p2);
+    BOOST_CHECK_EQUAL(0, reinterpret_cast<uintptr_t>(p2) % 8);
+    BOOST_CHECK_EQUAL(1024, a.capacity());
+
+    // Larger than a block
+    a.allocate(4000, 8);
+    BOOST_CHECK_EQUAL(1024 + 4000, a.capacity());
+
+    // The blocks are kept and reused
+    a.reset();
+    BOOST_CHECK(a.allocate(10, 1) == p1);
+    a.allocate(2000, 8);
+    BOOST_CHECK_EQUAL(1024 + 4000, a.capacity());
+
+    a.release();
+    BOOST_CHECK_EQUAL(0, a.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_parse)
+{
+    std::string s = R"(
+    {
+        "a string longer than a short string" : "another string longer than a short string",
+        "numbers" : [1,-2,3.5,1000000000000],
+        "nested" : {"true":true,"false":false,"null":null,"empty":[]}
+    }
+    )";
+
+    arena a;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        {
+            arena_json j = arena_json::parse(s, a);
+            BOOST_CHECK(a.capacity() > 0);
+
+            BOOST_CHECK_EQUAL(std::string("another string longer than a short string"), j["a string longer than a short string"].as<std::string>());
+            BOOST_CHECK_EQUAL(4, j["numbers"].size());
+            BOOST_CHECK_EQUAL(-2, j["numbers"][1].as<int>());
+            BOOST_CHECK(j["nested"]["true"].as<bool>());
+            BOOST_CHECK(j["nested"]["null"].is_null());
+
+            BOOST_CHECK_EQUAL(json::parse(s).to_string(), to_string(j));
+        }
+        size_t capacity = a.capacity();
+        a.reset();
+        BOOST_CHECK_EQUAL(capacity, a.capacity());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_modify)
+{
+    arena a;
+    arena_ojson j = arena_ojson::parse(R"({"b":[1,2],"a":"a string longer than a short string"})", a);
+
+    // Values built without an allocator are placed in arena containers
+    j["c"] = "a string longer than a short string from the heap";
+    j["b"].add(arena_ojson("a string longer than a short string from the arena", arena_allocator<char>(a)));
+
+    arena_ojson copy = j;
+    copy["a"] = 1;
+    j.erase("b");
+
+    BOOST_CHECK_EQUAL(std::string(R"({"a":"a string longer than a short string","c":"a string longer than a short string from the heap"})"), to_string(j));
+    BOOST_CHECK_EQUAL(std::string(R"({"b":[1,2,"a string longer than a short string from the arena"],"a":1,"c":"a string longer than a short string from the heap"})"), to_string(copy));
+}
+
+BOOST_AUTO_TEST_CASE(test_arena_parse_error)
+{
+    arena a;
+    BOOST_CHECK_THROW(arena_json::parse("[1,2", a), parse_exception);
+    a.reset();
+    arena_json j = arena_json::parse("[1,2]", a);
+    BOOST_CHECK_EQUAL(2, j.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
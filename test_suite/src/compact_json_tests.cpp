@@ -0,0 +1,99 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <ctime>
+#include <limits>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(compact_json_tests)
+
+typedef basic_json<char,compact_json_traits<char>> cjson;
+typedef basic_json<char,o_compact_json_traits<char>> cojson;
+
+BOOST_AUTO_TEST_CASE(test_compact_size)
+{
+    if (sizeof(void*) == 8)
+    {
+        BOOST_CHECK_EQUAL(8, sizeof(cjson));
+        BOOST_CHECK_EQUAL(8, sizeof(cojson));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_compact_scalars)
+{
+    BOOST_CHECK(cjson::null().is_null());
+    BOOST_CHECK(cjson(true).as<bool>());
+    BOOST_CHECK(!cjson(false).as<bool>());
+    BOOST_CHECK(cjson().is_object());
+    BOOST_CHECK_EQUAL(0, cjson().size());
+
+    BOOST_CHECK_EQUAL(-12, cjson(-12).as<int>());
+    BOOST_CHECK(cjson(-12).is_integer());
+    BOOST_CHECK_EQUAL(140737488355327, cjson(140737488355327).as<int64_t>());
+    BOOST_CHECK_EQUAL(-140737488355328, cjson(-140737488355328).as<int64_t>());
+    BOOST_CHECK_EQUAL((std::numeric_limits<int64_t>::min)(), cjson((std::numeric_limits<int64_t>::min)()).as<int64_t>());
+    BOOST_CHECK_EQUAL((std::numeric_limits<int64_t>::max)(), cjson((std::numeric_limits<int64_t>::max)()).as<int64_t>());
+    BOOST_CHECK_EQUAL((std::numeric_limits<uint64_t>::max)(), cjson((std::numeric_limits<uint64_t>::max)()).as<uint64_t>());
+    BOOST_CHECK(cjson((std::numeric_limits<uint64_t>::max)()).is_uinteger());
+
+    BOOST_CHECK_EQUAL(1.5, cjson(1.5).as<double>());
+    BOOST_CHECK_EQUAL(-(std::numeric_limits<double>::infinity)(), cjson(-(std::numeric_limits<double>::infinity)()).as<double>());
+    BOOST_CHECK(cjson(std::nan("")).is_double());
+    BOOST_CHECK(cjson(1.0) == cjson(1));
+    BOOST_CHECK(cjson(1) == cjson(1u));
+}
+
+BOOST_AUTO_TEST_CASE(test_compact_strings)
+{
+    cjson empty("");
+    cjson small("abcd");
+    cjson embedded(std::string("a\0b",3));
+    cjson large("a string longer than a short string");
+
+    BOOST_CHECK(empty.as<std::string>().empty());
+    BOOST_CHECK_EQUAL(std::string("abcd"), small.as<std::string>());
+    BOOST_CHECK_EQUAL(std::string("abcd"), std::string(small.as_cstring()));
+    BOOST_CHECK_EQUAL(3, embedded.as<std::string>().size());
+    BOOST_CHECK_EQUAL(std::string("a string longer than a short string"), large.as<std::string>());
+    BOOST_CHECK(small == cjson("abcd"));
+    BOOST_CHECK(small != large);
+}
+
+BOOST_AUTO_TEST_CASE(test_compact_parse)
+{
+    std::string s = R"({"a":[1,{"x":[]}],"big":-9223372036854775807,"d":1.5,"e":{},"f":false,"l":"a longer string","n":null,"s":"abcd","u":18446744073709551615})";
+
+    cjson j = cjson::parse(s);
+    BOOST_CHECK_EQUAL(s, j.to_string());
+    BOOST_CHECK_EQUAL(1, j["a"][0].as<int>());
+    BOOST_CHECK(j["a"][1]["x"].is_array());
+
+    cjson copy = j;
+    BOOST_CHECK(copy == j);
+    copy["a"].add(2);
+    copy["big"] = 1;
+    BOOST_CHECK(copy != j);
+    BOOST_CHECK_EQUAL(2, j["a"].size());
+    BOOST_CHECK_EQUAL(-9223372036854775807, j["big"].as<int64_t>());
+
+    cjson moved = std::move(copy);
+    BOOST_CHECK_EQUAL(3, moved["a"].size());
+    swap(moved, j);
+    BOOST_CHECK_EQUAL(2, moved["a"].size());
+
+    cojson o = cojson::parse(R"({"b":1,"a":"xyz"})");
+    BOOST_CHECK_EQUAL(std::string(R"({"b":1,"a":"xyz"})"), o.to_string());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
@@ -767,5 +767,16 @@ BOOST_AUTO_TEST_CASE(serialize_tab_delimited_file)
     }
 }
 
+BOOST_AUTO_TEST_CASE(serialize_integer_limits)
+{
+    json val = json::parse(R"([{"min":-9223372036854775808,"max":18446744073709551615,"zero":0,"negative":-1}])");
+
+    std::ostringstream os;
+    csv_serializer serializer(os);
+    val.dump(serializer);
+
+    BOOST_CHECK_EQUAL(std::string("max,min,negative,zero\n18446744073709551615,-9223372036854775808,-1,0"), os.str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -173,5 +173,27 @@ BOOST_AUTO_TEST_CASE(test_double_to_wstring)
     s = float_to_string<wchar_t>(x, format.precision());
     BOOST_CHECK(s == std::wstring(L"-11.0"));
 }
+
+BOOST_AUTO_TEST_CASE(test_shortest_double_to_string)
+{
+    BOOST_CHECK_EQUAL(std::string("0.30000000000000004"), float_to_string<char>(0.1+0.2, 0));
+    BOOST_CHECK_EQUAL(std::string("0.3"), float_to_string<char>(0.1+0.2, 15));
+    BOOST_CHECK_EQUAL(std::string("1.1"), float_to_string<char>(1.1, 0));
+    BOOST_CHECK_EQUAL(std::string("123456.789"), float_to_string<char>(123456.789, 0));
+    BOOST_CHECK_EQUAL(std::string("0.0001"), float_to_string<char>(0.0001, 0));
+    BOOST_CHECK_EQUAL(std::string("1.0e-05"), float_to_string<char>(0.00001, 0));
+    BOOST_CHECK_EQUAL(std::string("1.0e+15"), float_to_string<char>(1e15, 0));
+    BOOST_CHECK_EQUAL(std::string("-0.0"), float_to_string<char>(-0.0, 0));
+    BOOST_CHECK_EQUAL(std::string("1.7976931348623157e+308"), float_to_string<char>((std::numeric_limits<double>::max)(), 0));
+    BOOST_CHECK_EQUAL(std::string("5.0e-324"), float_to_string<char>((std::numeric_limits<double>::denorm_min)(), 0));
+
+    double x = 1.0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        x = x * 1.37 + 0.1;
+        std::string s = float_to_string<char>(x, 0);
+        BOOST_CHECK_EQUAL(x, std::strtod(s.c_str(), nullptr));
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,92 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <ctime>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(hashed_json_tests)
+
+typedef basic_json<char,hashed_json_traits<char>> hjson;
+
+BOOST_AUTO_TEST_CASE(test_hashed_set_and_erase)
+{
+    hjson j;
+    j["b"] = 1;
+    j["a"] = 2;
+    j.set("c", 3);
+    j["b"] = 4;
+
+    BOOST_CHECK_EQUAL(3, j.size());
+    BOOST_CHECK_EQUAL(4, j["b"].as<int>());
+    BOOST_CHECK_EQUAL(std::string(R"({"b":4,"a":2,"c":3})"), j.to_string());
+
+    // The last member takes the place of the erased one
+    j.erase("b");
+    BOOST_CHECK_EQUAL(std::string(R"({"c":3,"a":2})"), j.to_string());
+    j.erase("x");
+    BOOST_CHECK_EQUAL(2, j.size());
+    BOOST_CHECK(!j.has_member("b"));
+}
+
+BOOST_AUTO_TEST_CASE(test_hashed_large_object)
+{
+    const size_t count = 1000;
+    hjson j;
+    for (size_t i = 0; i < count; ++i)
+    {
+        j.set("key" + std::to_string(i), i);
+    }
+    BOOST_CHECK_EQUAL(count, j.size());
+
+    for (size_t i = 0; i < count; i += 2)
+    {
+        j.erase("key" + std::to_string(i));
+    }
+    BOOST_CHECK_EQUAL(count/2, j.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string name = "key" + std::to_string(i);
+        if (i % 2 == 0)
+        {
+            BOOST_CHECK(!j.has_member(name));
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL(i, j[name].as<size_t>());
+        }
+    }
+
+    hjson copy = j;
+    copy["key1"] = "changed";
+    BOOST_CHECK_EQUAL(1, j["key1"].as<int>());
+    BOOST_CHECK(copy != j);
+    copy["key1"] = 1;
+    BOOST_CHECK(copy == j);
+}
+
+BOOST_AUTO_TEST_CASE(test_hashed_parse)
+{
+    std::string s = R"({"b":1,"a":2,"b":3,"c":{"x":[1,2]}})";
+    hjson j = hjson::parse(s);
+
+    BOOST_CHECK_EQUAL(3, j.size());
+    BOOST_CHECK_EQUAL(3, j["b"].as<int>());
+    BOOST_CHECK_EQUAL(2, j["c"]["x"][1].as<int>());
+
+    // Equality does not depend on order
+    BOOST_CHECK(hjson::parse(R"({"c":{"x":[1,2]},"a":2,"b":3})") == j);
+    BOOST_CHECK_EQUAL(json::parse(s).to_string(), json::parse(j.to_string()).to_string());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
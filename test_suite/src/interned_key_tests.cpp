@@ -0,0 +1,120 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <ctime>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(interned_key_tests)
+
+typedef basic_json<char,interned_key_json_traits<char>> ijson;
+typedef basic_json<char,o_interned_key_json_traits<char>> iojson;
+typedef basic_interned_key<char> interned_key;
+
+BOOST_AUTO_TEST_CASE(test_interned_key)
+{
+    interned_key a("a name longer than a short string");
+    interned_key b(a);
+    interned_key c("a name longer than a short string");
+    interned_key empty;
+
+    BOOST_CHECK(a.shares_with(b));
+    BOOST_CHECK(!a.shares_with(c));
+    BOOST_CHECK(a == c);
+    BOOST_CHECK(empty < a);
+    BOOST_CHECK_EQUAL(0, empty.size());
+    BOOST_CHECK_EQUAL(std::string(""), std::string(empty.c_str()));
+    BOOST_CHECK_EQUAL(std::string("a name longer than a short string"), std::string(b.data(), b.size()));
+
+    interned_key d(std::move(b));
+    BOOST_CHECK(b.empty());
+    BOOST_CHECK(d.shares_with(a));
+    b = d;
+    BOOST_CHECK(b.shares_with(a));
+}
+
+BOOST_AUTO_TEST_CASE(test_decoder_shares_keys)
+{
+    std::string s = R"(
+    [
+        {"first_name":"Jane","last_name":"Roe","customer_number":1},
+        {"first_name":"John","last_name":"Doe","customer_number":2},
+        {"customer_number":3,"first_name":"Ann","last_name":"Poe"}
+    ]
+    )";
+
+    ijson j = ijson::parse(s);
+    BOOST_CHECK_EQUAL(3, j.size());
+
+    auto it0 = j[0].object_range().begin();
+    auto it1 = j[1].object_range().begin();
+    auto it2 = j[2].object_range().begin();
+    BOOST_CHECK(it0->key() == "customer_number");
+    BOOST_CHECK(it0->key().data() == it1->key().data());
+    BOOST_CHECK(it0->key().data() == it2->key().data());
+
+    BOOST_CHECK_EQUAL(std::string("John"), j[1]["first_name"].as<std::string>());
+    BOOST_CHECK(j[2].has_member("last_name"));
+    BOOST_CHECK_EQUAL(json::parse(s).to_string(), j.to_string());
+
+    ijson copy = j;
+    copy[0]["first_name"] = "Mary";
+    copy[0]["middle_name"] = "Ann";
+    BOOST_CHECK_EQUAL(std::string("Jane"), j[0]["first_name"].as<std::string>());
+    BOOST_CHECK(copy != j);
+    BOOST_CHECK(ijson::parse(s) == j);
+}
+
+BOOST_AUTO_TEST_CASE(test_decoder_shares_keys_preserve_order)
+{
+    std::string s = R"([{"b":1,"a":2,"customer_number":3},{"b":4,"a":5,"customer_number":6}])";
+
+    iojson j = iojson::parse(s);
+    auto it0 = j[0].object_range().begin();
+    auto it1 = j[1].object_range().begin();
+    BOOST_CHECK(it0->key() == "b");
+    BOOST_CHECK((it0+2)->key().data() == (it1+2)->key().data());
+
+    BOOST_CHECK_EQUAL(6, j[1]["customer_number"].as<int>());
+    BOOST_CHECK_EQUAL(s, j.to_string());
+
+    j[1].erase("a");
+    BOOST_CHECK_EQUAL(std::string(R"([{"b":1,"a":2,"customer_number":3},{"b":4,"customer_number":6}])"), j.to_string());
+}
+
+BOOST_AUTO_TEST_CASE(test_key_pool_full)
+{
+    typedef key_pool<interned_key> pool_type;
+    pool_type pool;
+    std::allocator<char> alloc;
+
+    std::string first = "name0";
+    interned_key a = pool.make_key(first.data(), first.length(), alloc);
+    for (size_t i = 1; i < pool_type::max_keys + 100; ++i)
+    {
+        std::string name = "name" + std::to_string(i);
+        pool.make_key(name.data(), name.length(), alloc);
+    }
+
+    // Names seen before the pool filled are still shared, new ones are not
+    interned_key b = pool.make_key(first.data(), first.length(), alloc);
+    BOOST_CHECK(a.shares_with(b));
+
+    std::string last = "a name not seen before";
+    interned_key c = pool.make_key(last.data(), last.length(), alloc);
+    interned_key d = pool.make_key(last.data(), last.length(), alloc);
+    BOOST_CHECK(c == d);
+    BOOST_CHECK(!c.shares_with(d));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
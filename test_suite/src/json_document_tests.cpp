@@ -0,0 +1,158 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_document.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <ctime>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(json_document_tests)
+
+static const std::string books = R"(
+{
+    "store" : {
+        "name" : "Corner \"Books\"",
+        "books" : [
+            {"title" : "Sayings of the Century", "price" : 8.95, "tags" : []},
+            {"title" : "Moby Dick", "price" : 8.99, "isbn" : "0-553-21311-3", "tags" : ["sea", "whale"]},
+            {"title" : "The Lord of the Rings", "price" : 22.99, "in print" : true, "tags" : ["fantasy"]}
+        ],
+        "open" : null,
+        "\u0063ity" : "Paris"
+    }
+}
+)";
+
+BOOST_AUTO_TEST_CASE(test_document_navigation)
+{
+    json_document<json> doc(books);
+    json_view<json> root = doc.root();
+
+    BOOST_CHECK(root.is_object());
+    BOOST_CHECK_EQUAL(1,root.size());
+    BOOST_CHECK(root.has_key("store"));
+    BOOST_CHECK(!root.has_key("shop"));
+
+    json_view<json> store = root["store"];
+    BOOST_CHECK_EQUAL(std::string("Corner \"Books\""),store["name"].as<std::string>());
+    BOOST_CHECK(store["open"].is_null());
+    BOOST_CHECK_EQUAL(std::string("Paris"),store.at("city").as<std::string>());
+
+    json_view<json> books = store["books"];
+    BOOST_CHECK(books.is_array());
+    BOOST_CHECK_EQUAL(3,books.size());
+    BOOST_CHECK_EQUAL(std::string("Moby Dick"),books[1]["title"].as<std::string>());
+    BOOST_CHECK_EQUAL(22.99,books.at(2).at("price").as<double>());
+    BOOST_CHECK(books[2]["in print"].as<bool>());
+    BOOST_CHECK_EQUAL(0,books[0]["tags"].size());
+    BOOST_CHECK(books[0]["tags"].array_range().begin() == books[0]["tags"].array_range().end());
+
+    std::vector<std::string> names;
+    for (auto member : books[1].object_range())
+    {
+        names.push_back(member.name());
+    }
+    std::vector<std::string> expected_names = {"title","price","isbn","tags"};
+    BOOST_CHECK(expected_names == names);
+
+    std::vector<std::string> tags;
+    for (auto tag : books[1]["tags"].array_range())
+    {
+        tags.push_back(tag.as<std::string>());
+    }
+    BOOST_CHECK_EQUAL(2,tags.size());
+    BOOST_CHECK_EQUAL(std::string("whale"),tags[1]);
+
+    BOOST_CHECK_THROW(store.at("address"),std::out_of_range);
+    BOOST_CHECK_THROW(books.at(3),std::out_of_range);
+    BOOST_CHECK_THROW(books.at("title"),std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_document_to_json)
+{
+    json_document<json> doc(books);
+
+    json expected = json::parse(books);
+    BOOST_CHECK(expected == doc.root().to_json());
+    BOOST_CHECK(expected["store"]["books"][1] == doc.root()["store"]["books"][1].to_json());
+    BOOST_CHECK(expected["store"]["books"] == doc.root()["store"]["books"].as<json>());
+}
+
+BOOST_AUTO_TEST_CASE(test_document_errors)
+{
+    // Errors in the structure are reported on construction
+    std::error_code ec;
+    try
+    {
+        json_document<json> doc("{\"a\":[1,2,],\"b\":3}");
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+    }
+    BOOST_CHECK(ec == json_parser_errc::extra_comma);
+
+    ec = std::error_code();
+    try
+    {
+        json_document<json> doc("{\"a\" 1}");
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+    }
+    BOOST_CHECK(ec == json_parser_errc::expected_colon);
+
+    // Errors in scalars are reported when they are used
+    json_document<json> doc("{\"a\":tru,\n\"b\":3,\"c\":\"\\x\"}");
+    BOOST_CHECK_EQUAL(3,doc.root()["b"].as<int>());
+
+    size_t line = 0;
+    size_t column = 0;
+    ec = std::error_code();
+    try
+    {
+        doc.root()["a"].as<bool>();
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+        line = e.line_number();
+        column = e.column_number();
+    }
+    BOOST_CHECK(ec == json_parser_errc::invalid_value);
+    BOOST_CHECK_EQUAL(1,line);
+    BOOST_CHECK_EQUAL(6,column);
+
+    ec = std::error_code();
+    try
+    {
+        doc.root()["c"].as<std::string>();
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+        line = e.line_number();
+    }
+    BOOST_CHECK(ec == json_parser_errc::illegal_escaped_character);
+    BOOST_CHECK_EQUAL(2,line);
+}
+
+BOOST_AUTO_TEST_CASE(test_document_wide)
+{
+    std::wstring s = L"{\"a\":[1,{\"b\":\"\\u00e9\"}]}";
+    json_document<wjson> doc(s);
+    BOOST_CHECK(doc.root()[L"a"][1][L"b"].as<std::wstring>() == L"\u00e9");
+    BOOST_CHECK(wjson::parse(s) == doc.root().to_json());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -14,6 +14,7 @@
 #include <jsoncons/json_serializer.hpp>
 #include <jsoncons/json_filter.hpp>
 #include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_structural_parser.hpp>
 #include <jsoncons/json.hpp>
 
 using namespace jsoncons;
@@ -171,4 +172,132 @@ BOOST_AUTO_TEST_CASE(test_chained_filters)
     BOOST_CHECK(j2["fourth"] == 4);
 }
 
+// Keeps the named members of the root object, and has the parser skip the others
+class projection_filter : public json_filter
+{
+    std::vector<std::string> names_;
+    size_t depth_;
+public:
+    size_t name_count;
+
+    projection_filter(const std::vector<std::string>& names, json_input_handler& handler)
+        : json_filter(handler), names_(names), depth_(0), name_count(0)
+    {
+    }
+
+private:
+    void do_begin_object(const parsing_context& context) override
+    {
+        ++depth_;
+        downstream_handler().begin_object(context);
+    }
+
+    void do_end_object(const parsing_context& context) override
+    {
+        --depth_;
+        downstream_handler().end_object(context);
+    }
+
+    void do_name(string_view_type name,
+                 const parsing_context& context) override
+    {
+        ++name_count;
+        if (depth_ == 1 && std::find(names_.begin(), names_.end(), std::string(name)) == names_.end())
+        {
+            skip_value();
+        }
+        else
+        {
+            downstream_handler().name(name,context);
+        }
+    }
+};
+
+static const std::string projection_input = R"({
+    "id" : 10,
+    "skipped1" : {"a" : [1, {"b" : "}]\"{["}], "c" : {}},
+    "name" : "x",
+    "skipped2" : [[], "\\", "]", [true,
+                  null]],
+    "skipped3" : -1.5e10,
+    "skipped4":"[{",
+    "tags" : ["a", {"b" : 2}],
+    "skipped5" : false
+})";
+
+BOOST_AUTO_TEST_CASE(test_skip_value)
+{
+    json expected = json::parse(projection_input);
+    expected.erase("skipped1");
+    expected.erase("skipped2");
+    expected.erase("skipped3");
+    expected.erase("skipped4");
+    expected.erase("skipped5");
+    std::vector<std::string> names = {"id","name","tags"};
+
+    for (size_t n = 1; n <= projection_input.length(); ++n)
+    {
+        json_decoder<json> decoder;
+        projection_filter filter(names, decoder);
+        json_parser parser(filter);
+        for (size_t pos = 0; pos < projection_input.length(); pos += n)
+        {
+            parser.feed(projection_input.data() + pos, (std::min)(n, projection_input.length() - pos));
+        }
+        BOOST_REQUIRE(parser.finish() == feed_status::document_done);
+        BOOST_CHECK(expected == decoder.get_result());
+        BOOST_CHECK_EQUAL(9,filter.name_count);
+    }
+
+    json_decoder<json> decoder;
+    projection_filter filter(names, decoder);
+    json_structural_parser parser(filter);
+    parser.parse(projection_input.data(), projection_input.length());
+    BOOST_CHECK(expected == decoder.get_result());
+    BOOST_CHECK_EQUAL(9,filter.name_count);
+}
+
+static void check_skip_value_error_position(const std::string& input)
+{
+    size_t expected_line = 0;
+    size_t expected_column = 0;
+    try
+    {
+        json::parse(input);
+    }
+    catch (const parse_exception& e)
+    {
+        expected_line = e.line_number();
+        expected_column = e.column_number();
+    }
+    BOOST_CHECK_EQUAL(11,expected_line);
+
+    for (size_t n = 1; n <= input.length(); ++n)
+    {
+        json_decoder<json> decoder;
+        projection_filter filter({"id"}, decoder);
+        json_parser parser(filter);
+        feed_status status = feed_status::need_more;
+        for (size_t pos = 0; pos < input.length() && status == feed_status::need_more; pos += n)
+        {
+            status = parser.feed(input.data() + pos, (std::min)(n, input.length() - pos));
+        }
+        BOOST_CHECK(status == feed_status::error);
+        BOOST_CHECK_EQUAL(expected_line,parser.parsing_context().line_number());
+        BOOST_CHECK_EQUAL(expected_column,parser.parsing_context().column_number());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_skip_value_error_position)
+{
+    std::string input = projection_input.substr(0, projection_input.length() - 1) + ",}";
+    std::string crlf_input;
+    for (auto c : input)
+    {
+        crlf_input += c == '\n' ? std::string("\r\n") : std::string(1, c);
+    }
+    check_skip_value_error_position(input);
+    check_skip_value_error_position(crlf_input);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
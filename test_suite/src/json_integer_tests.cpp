@@ -62,5 +62,69 @@ BOOST_AUTO_TEST_CASE(test_integer_limits)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_integer_overflow_boundaries)
+{
+    // Values on both sides of the int64_t and uint64_t limits, read with every buffer size
+    std::string input = "[18446744073709551615,18446744073709551616,-9223372036854775808,-9223372036854775809,"
+                        "123456789012345678901234567890,0,-0,12.5,0e1,120e-1]";
+
+    for (size_t i = 1; i <= input.length(); ++i)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder);
+        reader.buffer_capacity(i);
+        reader.read_next();
+        json val = decoder.get_result();
+
+        BOOST_REQUIRE(val[0].is_uinteger());
+        BOOST_CHECK(val[0].as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+        BOOST_REQUIRE(val[1].is_double());
+        BOOST_CHECK_EQUAL(18446744073709551616.0,val[1].as<double>());
+        BOOST_CHECK_EQUAL(20,val[1].double_precision());
+        BOOST_REQUIRE(val[2].is_integer());
+        BOOST_CHECK(val[2].as<int64_t>() == (std::numeric_limits<int64_t>::min)());
+        BOOST_REQUIRE(val[3].is_double());
+        BOOST_CHECK_EQUAL(-9223372036854775809.0,val[3].as<double>());
+        BOOST_CHECK_EQUAL(19,val[3].double_precision());
+        BOOST_REQUIRE(val[4].is_double());
+        BOOST_CHECK_EQUAL(123456789012345678901234567890.0,val[4].as<double>());
+        BOOST_CHECK(val[5].is_uinteger());
+        BOOST_CHECK_EQUAL(0,val[5].as<int>());
+        BOOST_CHECK(val[6].is_integer());
+        BOOST_CHECK_EQUAL(12.5,val[7].as<double>());
+        BOOST_CHECK_EQUAL(3,val[7].double_precision());
+        BOOST_CHECK_EQUAL(0.0,val[8].as<double>());
+        BOOST_CHECK_EQUAL(12.0,val[9].as<double>());
+        BOOST_CHECK_EQUAL(3,val[9].double_precision());
+
+        BOOST_CHECK(val == json::parse(input, parse_engine::structural));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_integer_to_string)
+{
+    std::vector<int64_t> values = {0, -1, (std::numeric_limits<int64_t>::min)(), (std::numeric_limits<int64_t>::max)()};
+    // 10^19 still fits a uint64_t after the last pass
+    uint64_t power = 1;
+    for (size_t i = 0; i < 19; ++i, power *= 10)
+    {
+        int64_t value = static_cast<int64_t>(power);
+        values.push_back(value - 1);
+        values.push_back(value);
+        values.push_back(-value);
+    }
+    for (auto value : values)
+    {
+        BOOST_CHECK_EQUAL(std::to_string(value), json(value).to_string());
+        BOOST_CHECK(std::to_wstring(value) == wjson(value).to_string());
+    }
+
+    uint64_t max_value = (std::numeric_limits<uint64_t>::max)();
+    BOOST_CHECK_EQUAL(std::string("18446744073709551615"), json(max_value).to_string());
+    BOOST_CHECK_EQUAL(std::string("10000000000000000000"), json(uint64_t(10000000000000000000ull)).to_string());
+    BOOST_CHECK_EQUAL(std::string("9999999999999999999"), json(uint64_t(9999999999999999999ull)).to_string());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
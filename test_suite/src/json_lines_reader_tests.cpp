@@ -0,0 +1,208 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_lines_reader.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <ctime>
+#include <thread>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(json_lines_reader_tests)
+
+static std::string make_lines(size_t count, std::vector<json>& expected)
+{
+    std::string s;
+    for (size_t i = 0; i < count; ++i)
+    {
+        json val;
+        val["id"] = i;
+        val["name"] = std::string(i % 37, 'x');
+        val["values"] = json::array{1.5, -2, true, json::null()};
+        expected.push_back(val);
+        s += val.to_string();
+        s += i % 3 == 0 ? "\r\n" : "\n";
+    }
+    return s;
+}
+
+BOOST_AUTO_TEST_CASE(test_read_lines)
+{
+    std::vector<json> expected;
+    std::string s = make_lines(1000, expected);
+
+    std::vector<size_t> capacities = {7, 100, 4096, 1024*1024};
+    for (size_t num_threads = 1; num_threads <= 4; num_threads += 3)
+    {
+        for (size_t capacity : capacities)
+        {
+            std::istringstream is(s);
+            json_lines_reader reader(is);
+            reader.num_threads(num_threads);
+            reader.buffer_capacity(capacity);
+
+            std::vector<json> values;
+            while (!reader.eof())
+            {
+                reader.read_next(values);
+            }
+            BOOST_CHECK_EQUAL(0,reader.read_next(values));
+            BOOST_REQUIRE_EQUAL(expected.size(),values.size());
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                BOOST_CHECK(expected[i] == values[i]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_read_lines_callback)
+{
+    std::vector<json> expected;
+    std::string s = make_lines(200, expected);
+
+    std::istringstream is(s);
+    json_lines_reader reader(is);
+    reader.num_threads(4);
+    reader.buffer_capacity(256);
+
+    size_t count = 0;
+    reader.read<json>([&](const json& val)
+    {
+        BOOST_CHECK(expected[count] == val);
+        ++count;
+    });
+    BOOST_CHECK_EQUAL(expected.size(),count);
+}
+
+BOOST_AUTO_TEST_CASE(test_read_lines_blank_lines)
+{
+    std::istringstream is("\n  \n{\"a\":1}\n\t\r\n[2]\n\n 3");
+    json_lines_reader reader(is);
+
+    std::vector<json> values;
+    while (!reader.eof())
+    {
+        reader.read_next(values);
+    }
+    BOOST_REQUIRE_EQUAL(3,values.size());
+    BOOST_CHECK_EQUAL(1,values[0]["a"].as<int>());
+    BOOST_CHECK_EQUAL(2,values[1][0].as<int>());
+    BOOST_CHECK_EQUAL(3,values[2].as<int>());
+}
+
+BOOST_AUTO_TEST_CASE(test_read_lines_error)
+{
+    std::istringstream is("{\"a\":1}\n[2]\n\n[1,2,]\n4 5\n[6]");
+    json_lines_reader reader(is);
+    reader.num_threads(2);
+
+    std::vector<json> values;
+    size_t line = 0;
+    size_t column = 0;
+    std::error_code ec;
+    try
+    {
+        reader.read_next(values);
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+        line = e.line_number();
+        column = e.column_number();
+    }
+    BOOST_CHECK(ec == json_parser_errc::extra_comma);
+    BOOST_CHECK_EQUAL(4,line);
+    BOOST_CHECK_EQUAL(6,column);
+    BOOST_CHECK_EQUAL(2,values.size());
+
+    // Continues with the next line
+    ec = std::error_code();
+    try
+    {
+        reader.read_next(values);
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+        line = e.line_number();
+    }
+    BOOST_CHECK(ec == json_parser_errc::extra_character);
+    BOOST_CHECK_EQUAL(5,line);
+
+    BOOST_CHECK_EQUAL(1,reader.read_next(values));
+    BOOST_REQUIRE_EQUAL(3,values.size());
+    BOOST_CHECK_EQUAL(6,values[2][0].as<int>());
+    BOOST_CHECK(reader.eof());
+}
+
+// Not safe to call concurrently
+class counting_error_handler : public parse_error_handler
+{
+public:
+    size_t count;
+    bool busy;
+    bool overlapped;
+
+    counting_error_handler()
+        : count(0), busy(false), overlapped(false)
+    {
+    }
+private:
+    bool do_error(std::error_code ec, const parsing_context&) override
+    {
+        if (busy)
+        {
+            overlapped = true;
+        }
+        busy = true;
+        ++count;
+        std::this_thread::yield();
+        busy = false;
+        return ec != json_parser_errc::illegal_comment;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(test_read_lines_error_handler)
+{
+    std::string s;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        s += "[1,/* a comment */2]\n";
+    }
+    std::istringstream is(s);
+    counting_error_handler err_handler;
+    json_lines_reader reader(is, err_handler);
+    reader.num_threads(4);
+
+    std::vector<json> values;
+    while (!reader.eof())
+    {
+        reader.read_next(values);
+    }
+    BOOST_CHECK_EQUAL(1000,values.size());
+    BOOST_CHECK_EQUAL(1000,err_handler.count);
+    BOOST_CHECK(!err_handler.overlapped);
+}
+
+BOOST_AUTO_TEST_CASE(test_read_lines_wide)
+{
+    std::wistringstream is(L"{\"a\":\"\\u00e9\"}\n[1,2]\n");
+    wjson_lines_reader reader(is);
+
+    std::vector<wjson> values;
+    reader.read_next(values);
+    BOOST_REQUIRE_EQUAL(2,values.size());
+    BOOST_CHECK(values[0][L"a"].as<std::wstring>() == L"\u00e9");
+    BOOST_CHECK_EQUAL(2,values[1].size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
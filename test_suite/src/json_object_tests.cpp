@@ -858,5 +858,37 @@ BOOST_AUTO_TEST_CASE(test_set_override)
     BOOST_CHECK_CLOSE(obj["height"].as<double>(),0.3,0.00000000001);
 }
 
+BOOST_AUTO_TEST_CASE(test_parse_member_order)
+{
+    std::string expected = R"({"a":1,"b":2,"c":3,"d":4})";
+
+    // Sorted, nearly sorted and unsorted members
+    BOOST_CHECK_EQUAL(expected, json::parse(R"({"a":1,"b":2,"c":3,"d":4})").to_string());
+    BOOST_CHECK_EQUAL(expected, json::parse(R"({"b":2,"a":1,"c":3,"d":4})").to_string());
+    BOOST_CHECK_EQUAL(expected, json::parse(R"({"d":4,"c":3,"b":2,"a":1})").to_string());
+
+    // The last of the members with the same name is kept
+    BOOST_CHECK_EQUAL(expected, json::parse(R"({"a":0,"a":1,"b":2,"c":3,"d":0,"d":4})").to_string());
+    BOOST_CHECK_EQUAL(expected, json::parse(R"({"d":0,"b":0,"a":1,"c":3,"b":2,"d":4})").to_string());
+
+    std::string s = "{";
+    for (size_t i = 0; i < 100; ++i)
+    {
+        if (i > 0)
+        {
+            s.push_back(',');
+        }
+        s += "\"" + std::to_string((i*37) % 100) + "\":" + std::to_string(i);
+    }
+    s.push_back('}');
+    json j = json::parse(s);
+    BOOST_CHECK_EQUAL(100, j.size());
+    for (auto it = j.object_range().begin() + 1; it != j.object_range().end(); ++it)
+    {
+        BOOST_CHECK((it-1)->key() < it->key());
+    }
+    BOOST_CHECK_EQUAL(1, j["37"].as<int>());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
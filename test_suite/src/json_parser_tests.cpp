@@ -201,6 +201,141 @@ BOOST_AUTO_TEST_CASE(test_array_string)
     json j = decoder.get_result();
 }
 
+BOOST_AUTO_TEST_CASE(test_whitespace_line_numbers)
+{
+    // The error is at the x, on line 6 column 3, whichever way the input is split
+    std::string s = "[\r\n  1,\r  \t2,\n\n\r\n\t x]";
+
+    for (size_t i = 1; i < s.length(); ++i)
+    {
+        jsoncons::json_decoder<json> decoder;
+        json_parser parser(decoder);
+
+        size_t line = 0;
+        size_t column = 0;
+        try
+        {
+            parser.set_source(s.data(),i);
+            parser.parse();
+            parser.set_source(s.data()+i,s.length()-i);
+            parser.parse();
+        }
+        catch (const parse_exception& e)
+        {
+            line = e.line_number();
+            column = e.column_number();
+        }
+        BOOST_CHECK_EQUAL(6,line);
+        BOOST_CHECK_EQUAL(3,column);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_feed)
+{
+    std::string input = "{\"name\":\"value\",\"values\":[1,-2.5e3,true,null,\"a\\u00e9b\"]}";
+    json expected = json::parse(input);
+
+    for (size_t i = 1; i <= input.length(); ++i)
+    {
+        jsoncons::json_decoder<json> decoder;
+        json_parser parser(decoder);
+
+        // Each chunk is copied to a buffer that is overwritten by the next one
+        std::vector<char> buffer(i);
+        feed_status status = feed_status::need_more;
+        for (size_t pos = 0; pos < input.length(); pos += i)
+        {
+            size_t length = (std::min)(i, input.length() - pos);
+            std::copy(input.data() + pos, input.data() + pos + length, buffer.begin());
+            status = parser.feed(buffer.data(), length);
+            std::fill(buffer.begin(), buffer.end(), '#');
+            if (pos + length < input.length())
+            {
+                BOOST_CHECK(status == feed_status::need_more);
+            }
+        }
+        BOOST_CHECK(status == feed_status::document_done);
+        BOOST_CHECK_EQUAL(0,parser.unconsumed());
+        BOOST_CHECK(parser.finish() == feed_status::document_done);
+        BOOST_CHECK(expected == decoder.get_result());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_feed_defer_partial_strings)
+{
+    std::string input = "[\"hello world\", 1]";
+
+    jsoncons::json_decoder<json> decoder;
+    json_parser parser(decoder);
+    parser.defer_partial_strings(true);
+
+    // feed copies a string that crosses chunks even with deferral on
+    feed_status status = feed_status::need_more;
+    for (size_t pos = 0; pos < input.length(); pos += 4)
+    {
+        std::string chunk = input.substr(pos, 4);
+        status = parser.feed(chunk.data(), chunk.length());
+    }
+    BOOST_CHECK(status == feed_status::document_done);
+    BOOST_CHECK(parser.defer_partial_strings());
+    BOOST_CHECK(json::parse(input) == decoder.get_result());
+}
+
+BOOST_AUTO_TEST_CASE(test_feed_number)
+{
+    jsoncons::json_decoder<json> decoder;
+    json_parser parser(decoder);
+
+    std::string s1 = " 12";
+    std::string s2 = "34";
+    BOOST_CHECK(parser.feed(s1.data(),s1.length()) == feed_status::need_more);
+    BOOST_CHECK(parser.feed(s2.data(),s2.length()) == feed_status::need_more);
+    BOOST_CHECK(parser.finish() == feed_status::document_done);
+    BOOST_CHECK_EQUAL(1234,decoder.get_result().as<int>());
+}
+
+BOOST_AUTO_TEST_CASE(test_feed_multiple_documents)
+{
+    jsoncons::json_decoder<json> decoder;
+    json_parser parser(decoder);
+
+    std::string s = "{\"a\":1}\n[2] ";
+    BOOST_CHECK(parser.feed(s.data(),s.length()) == feed_status::document_done);
+    BOOST_CHECK_EQUAL(5,parser.unconsumed());
+    BOOST_CHECK_EQUAL(1,decoder.get_result()["a"].as<int>());
+
+    parser.reset();
+    BOOST_CHECK(parser.feed(s.data() + s.length() - parser.unconsumed(),parser.unconsumed()) == feed_status::document_done);
+    BOOST_CHECK_EQUAL(2,decoder.get_result()[0].as<int>());
+
+    parser.reset();
+    BOOST_CHECK(parser.finish() == feed_status::error);
+    BOOST_CHECK(parser.feed_error() == json_parser_errc::unexpected_eof);
+}
+
+BOOST_AUTO_TEST_CASE(test_feed_error)
+{
+    jsoncons::json_decoder<json> decoder;
+    json_parser parser(decoder);
+
+    std::string s1 = "[1,\n";
+    std::string s2 = "  2,]";
+    BOOST_CHECK(parser.feed(s1.data(),s1.length()) == feed_status::need_more);
+    BOOST_CHECK(parser.feed(s2.data(),s2.length()) == feed_status::error);
+    BOOST_CHECK(parser.feed_error() == json_parser_errc::extra_comma);
+    BOOST_CHECK_EQUAL(2,parser.parsing_context().line_number());
+    BOOST_CHECK_EQUAL(5,parser.parsing_context().column_number());
+
+    // The error is kept until reset
+    BOOST_CHECK(parser.feed(s2.data(),s2.length()) == feed_status::error);
+    BOOST_CHECK(parser.finish() == feed_status::error);
+
+    parser.reset();
+    std::string s3 = "[3]";
+    BOOST_CHECK(parser.feed(s3.data(),s3.length()) == feed_status::document_done);
+    BOOST_CHECK_EQUAL(3,decoder.get_result()[0].as<int>());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -196,6 +196,44 @@ BOOST_AUTO_TEST_CASE(test_serialization_1)
     BOOST_CHECK_EQUAL(expected7,os7.str());
 }
 
+BOOST_AUTO_TEST_CASE(test_escape_positions)
+{
+    struct escape_case
+    {
+        std::string raw;
+        std::string escaped;
+        bool escape_solidus;
+        bool escape_all_non_ascii;
+    };
+    std::vector<escape_case> cases = {
+        {"\"", "\\\"", false, false},
+        {"\\", "\\\\", false, false},
+        {"\n", "\\n", false, false},
+        {"\x01", "\\u0001", false, false},
+        {"\x7f", "\\u007F", false, false},
+        {"/", "/", false, false},
+        {"/", "\\/", true, false},
+        {"\xc3\xa9", "\xc3\xa9", false, false},
+        {"\xc3\xa9", "\\u00E9", false, true}
+    };
+
+    for (const auto& c : cases)
+    {
+        serialization_options options;
+        options.escape_solidus(c.escape_solidus)
+               .escape_all_non_ascii(c.escape_all_non_ascii);
+        for (size_t length = 1; length <= 70; ++length)
+        {
+            for (size_t pos = 0; pos < length; ++pos)
+            {
+                std::string s = std::string(pos, 'a') + c.raw + std::string(length - pos - 1, 'b');
+                std::string expected = "\"" + std::string(pos, 'a') + c.escaped + std::string(length - pos - 1, 'b') + "\"";
+                BOOST_CHECK_EQUAL(expected, json(s).to_string(options));
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
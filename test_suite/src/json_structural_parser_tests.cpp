@@ -0,0 +1,331 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_structural_parser.hpp>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <ctime>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(json_structural_parser_tests)
+
+static std::string read_file(const boost::filesystem::path& path)
+{
+    std::ifstream is(path.c_str(), std::ios::binary);
+    std::ostringstream os;
+    os << is.rdbuf();
+    return os.str();
+}
+
+static void check_structural_parse(const std::string& input, const std::string& label)
+{
+    json expected;
+    std::error_code expected_ec;
+    try
+    {
+        expected = json::parse(input);
+    }
+    catch (const std::exception&)
+    {
+        expected_ec = json_parser_errc::invalid_json_text;
+    }
+
+    json result;
+    std::error_code ec;
+    try
+    {
+        result = json::parse(input, parse_engine::structural);
+    }
+    catch (const std::exception&)
+    {
+        ec = json_parser_errc::invalid_json_text;
+    }
+
+    BOOST_CHECK_MESSAGE(expected_ec == ec, label);
+    if (!ec)
+    {
+        BOOST_CHECK_MESSAGE(expected == result, label);
+        BOOST_CHECK_MESSAGE(expected.to_string() == result.to_string(), label);
+    }
+}
+
+static std::error_code structural_error(const std::string& input)
+{
+    std::error_code ec;
+    try
+    {
+        json_decoder<json> decoder;
+        json_structural_parser parser(decoder);
+        parser.parse(input.data(), input.length());
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+    }
+    return ec;
+}
+
+BOOST_AUTO_TEST_CASE(test_structural_parse_JSONTestSuite)
+{
+    boost::filesystem::path p("input/JSONTestSuite");
+
+    if (exists(p) && is_directory(p))
+    {
+        boost::filesystem::directory_iterator end_iter;
+        for (boost::filesystem::directory_iterator dir_itr(p);
+            dir_itr != end_iter;
+            ++dir_itr)
+        {
+            if (is_regular_file(dir_itr->status()) && dir_itr->path().extension() == ".json" &&
+                dir_itr->path().filename().string().find("utf16") == std::string::npos)
+            {
+                std::string input = read_file(dir_itr->path());
+                check_structural_parse(input, dir_itr->path().filename().string());
+
+                char kind = dir_itr->path().filename().c_str()[0];
+                if (kind == 'y')
+                {
+                    std::error_code ec = structural_error(input);
+                    BOOST_CHECK_MESSAGE(!ec, dir_itr->path().filename().string() + " should pass");
+                }
+                else if (kind == 'n')
+                {
+                    std::error_code ec = structural_error(input);
+                    BOOST_CHECK_MESSAGE(ec, dir_itr->path().filename().string() + " should fail");
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_structural_parse_files)
+{
+    std::vector<std::string> files = {"input/countries.json", "input/address-book.json",
+                                      "input/employees.json", "input/locations.json",
+                                      "input/members.json", "input/persons.json"};
+    for (const auto& file : files)
+    {
+        check_structural_parse(read_file(file), file);
+    }
+
+    json expected = json::parse_file("input/countries.json");
+    json result = json::parse_file("input/countries.json", parse_engine::structural);
+    BOOST_CHECK(expected == result);
+}
+
+BOOST_AUTO_TEST_CASE(test_structural_parse_block_boundaries)
+{
+    // Move strings, escapes and scalars across the 64 character block boundaries
+    for (size_t i = 0; i < 140; ++i)
+    {
+        std::string pad(i, ' ');
+        std::string key(i, 'k');
+        check_structural_parse(pad + "[\"" + key + "\\\\\",\"\\\"\",-12.5e+3,true]", "escapes " + std::to_string(i));
+        check_structural_parse("{\"" + key + "\":[" + pad + "123456789012345678901234567890,null]}", "numbers " + std::to_string(i));
+        check_structural_parse("[\"" + key + "\\u00e9\\ud83d\\ude00\"," + pad + "false]", "unicode " + std::to_string(i));
+        check_structural_parse("[\"" + key + "\\\\\\\"\"]" + pad, "backslashes " + std::to_string(i));
+        check_structural_parse("[\"" + key + "]", "unclosed " + std::to_string(i));
+        check_structural_parse("[1," + pad + "]", "extra comma " + std::to_string(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_structural_parse_errors)
+{
+    BOOST_CHECK(structural_error("[1,2") == json_parser_errc::unexpected_eof);
+    BOOST_CHECK(structural_error("") == json_parser_errc::unexpected_eof);
+    BOOST_CHECK(structural_error("[1,]") == json_parser_errc::extra_comma);
+    BOOST_CHECK(structural_error("{\"a\":1,}") == json_parser_errc::extra_comma);
+    BOOST_CHECK(structural_error("[1] 2") == json_parser_errc::extra_character);
+    BOOST_CHECK(structural_error("[01]") == json_parser_errc::leading_zero);
+    BOOST_CHECK(structural_error("[tru]") == json_parser_errc::invalid_value);
+    BOOST_CHECK(structural_error("{\"a\" 1}") == json_parser_errc::expected_colon);
+    BOOST_CHECK(structural_error("[\"a\tb\"]") == json_parser_errc::illegal_control_character);
+    BOOST_CHECK(structural_error("[\"\\x\"]") == json_parser_errc::illegal_escaped_character);
+    BOOST_CHECK(structural_error("[\"\xE2\x82\"]") == json_parser_errc::expected_continuation_byte);
+    BOOST_CHECK(structural_error("[1 /* comment */]") == json_parser_errc::expected_comma_or_right_bracket);
+}
+
+BOOST_AUTO_TEST_CASE(test_structural_parse_error_position)
+{
+    std::string input = "{\n  \"a\" : [1,\r\n    2,,\n  ]\n}";
+
+    size_t line = 0;
+    size_t column = 0;
+    try
+    {
+        json_decoder<json> decoder;
+        json_structural_parser parser(decoder);
+        parser.parse(input.data(), input.length());
+    }
+    catch (const parse_exception& e)
+    {
+        BOOST_CHECK(e.code() == json_parser_errc::expected_value);
+        line = e.line_number();
+        column = e.column_number();
+    }
+    BOOST_CHECK_EQUAL(3,line);
+    BOOST_CHECK_EQUAL(7,column);
+}
+
+BOOST_AUTO_TEST_CASE(test_structural_parse_fallback)
+{
+    // Comments are accepted by the default error handler of the incremental parser
+    json j = json::parse("[1, /* comment */ 2]", parse_engine::structural);
+    BOOST_CHECK_EQUAL(2,j.size());
+
+    // The error position is the one reported by the incremental parser
+    std::string input = "[1,2,,3]";
+    size_t expected_column = 0;
+    try
+    {
+        json::parse(input);
+    }
+    catch (const parse_exception& e)
+    {
+        expected_column = e.column_number();
+    }
+    size_t column = 0;
+    try
+    {
+        json::parse(input, parse_engine::structural);
+    }
+    catch (const parse_exception& e)
+    {
+        column = e.column_number();
+    }
+    BOOST_CHECK_EQUAL(expected_column,column);
+}
+
+BOOST_AUTO_TEST_CASE(test_structural_parse_max_nesting_depth)
+{
+    std::string input = "[[[[1]]]]";
+
+    json_decoder<json> decoder;
+    json_structural_parser parser(decoder);
+    parser.max_nesting_depth(5);
+    parser.parse(input.data(), input.length());
+    BOOST_CHECK(decoder.is_valid());
+
+    std::error_code ec;
+    try
+    {
+        json_decoder<json> decoder2;
+        json_structural_parser parser2(decoder2);
+        parser2.max_nesting_depth(4);
+        parser2.parse(input.data(), input.length());
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+    }
+    BOOST_CHECK(ec == json_parser_errc::max_depth_exceeded);
+}
+
+BOOST_AUTO_TEST_CASE(test_structural_parse_wide)
+{
+    std::wstring input = L"{\"name\":\"\\u00e9t\\u00e9\",\"values\":[1,-2,3.5e1,true,null]}";
+    wjson expected = wjson::parse(input);
+    wjson result = wjson::parse(input, parse_engine::structural);
+    BOOST_CHECK(expected == result);
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_array_elements)
+{
+    std::string input = "[ {\"a\":[1,2]} , \"x,]\" ,3, [[]] ]";
+
+    basic_structural_index<char> index;
+    BOOST_REQUIRE(index.build(input.data(), input.length()));
+
+    // The commas between the elements are at 10, 12 and 14, the closing bracket at 19
+    json_decoder<json> decoder;
+    json_structural_parser parser(decoder);
+    parser.parse_array_elements(input.data(), input.length(), index, 1, 14);
+    json result = decoder.get_result();
+    BOOST_REQUIRE_EQUAL(3,result.size());
+    BOOST_CHECK(result[0] == json::parse("{\"a\":[1,2]}"));
+    BOOST_CHECK_EQUAL(std::string("x,]"),result[1].as<std::string>());
+    BOOST_CHECK_EQUAL(3,result[2].as<int>());
+
+    parser.parse_array_elements(input.data(), input.length(), index, 15, 19);
+    result = decoder.get_result();
+    BOOST_REQUIRE_EQUAL(1,result.size());
+    BOOST_CHECK(result[0] == json::parse("[[]]"));
+
+    // A range that ends inside an element
+    std::error_code ec;
+    try
+    {
+        parser.parse_array_elements(input.data(), input.length(), index, 1, 6);
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+    }
+    BOOST_CHECK(ec == json_parser_errc::expected_value);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_parse)
+{
+    std::string input = "[";
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        if (i > 0)
+        {
+            input += i % 7 == 0 ? ",\n" : ",";
+        }
+        input += "{\"id\":" + std::to_string(i) + ",\"text\":\"a,b]c\\\"[d}\",\"values\":[1.5,[],{},null]}";
+    }
+    input += "]";
+
+    json expected = json::parse(input);
+    json result = json::parse(input, parse_engine::parallel);
+    BOOST_CHECK(expected == result);
+
+    check_structural_parse("[1,[2,3],{\"a\":4}]", "small");
+
+    // Errors are reported at the position in the whole input
+    std::vector<std::string> inputs = {input.substr(0, input.length() - 1) + ",]",
+                                       input.substr(0, input.length() / 2) + "x" + input.substr(input.length() / 2),
+                                       input + " 1",
+                                       input.substr(0, input.length() - 1)};
+    for (const auto& s : inputs)
+    {
+        size_t expected_line = 0;
+        size_t expected_column = 0;
+        try
+        {
+            json::parse(s);
+        }
+        catch (const parse_exception& e)
+        {
+            expected_line = e.line_number();
+            expected_column = e.column_number();
+        }
+        size_t line = 0;
+        size_t column = 0;
+        try
+        {
+            json::parse(s, parse_engine::parallel);
+        }
+        catch (const parse_exception& e)
+        {
+            line = e.line_number();
+            column = e.column_number();
+        }
+        BOOST_CHECK(expected_line != 0);
+        BOOST_CHECK_EQUAL(expected_line,line);
+        BOOST_CHECK_EQUAL(expected_column,column);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
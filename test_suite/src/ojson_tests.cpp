@@ -74,5 +74,55 @@ BOOST_AUTO_TEST_CASE(test_object)
     o.erase("unit_type");
 }
 
+BOOST_AUTO_TEST_CASE(test_large_object)
+{
+    // Past the threshold the members have a hash index, which must follow
+    // every change to the members
+    const size_t count = 200;
+    std::ostringstream os;
+    os << "{";
+    for (size_t i = 0; i < count; ++i)
+    {
+        os << "\"k" << i << "\":" << i << ",";
+    }
+    os << "\"k10\":-10,\"k20\":-20}";
+
+    ojson o = ojson::parse(os.str());
+    BOOST_CHECK_EQUAL(count, o.size());
+    BOOST_CHECK_EQUAL(std::string("k0"), std::string(o.object_range().begin()->key()));
+    BOOST_CHECK_EQUAL(std::string("k20"), std::string((o.object_range().end()-1)->key()));
+    BOOST_CHECK_EQUAL(-10, o["k10"].as<int>());
+    BOOST_CHECK_EQUAL(199, o["k199"].as<int>());
+    BOOST_CHECK(!o.has_member("k200"));
+
+    o.set("k200", 200);
+    BOOST_CHECK_EQUAL(200, o["k200"].as<int>());
+
+    o.erase("k0");
+    BOOST_CHECK(!o.has_member("k0"));
+    BOOST_CHECK_EQUAL(1, o["k1"].as<int>());
+    BOOST_CHECK_EQUAL(200, o["k200"].as<int>());
+
+    auto it = o.find("k5");
+    o.set(it, "inserted", true);
+    BOOST_CHECK(o["inserted"].as<bool>());
+    BOOST_CHECK(o.find("k5") == o.find("inserted") + 1);
+    BOOST_CHECK_EQUAL(5, o["k5"].as<int>());
+
+    const ojson c = o;
+    BOOST_CHECK(c == o);
+    BOOST_CHECK_EQUAL(150, c["k150"].as<int>());
+
+    ojson s;
+    s.swap(o);
+    BOOST_CHECK_EQUAL(150, s["k150"].as<int>());
+    BOOST_CHECK(o.find("k150") == o.object_range().end());
+
+    s.erase(s.object_range().begin(), s.object_range().begin() + 190);
+    BOOST_CHECK_EQUAL(11, s.size());
+    BOOST_CHECK_EQUAL(199, s["k199"].as<int>());
+    BOOST_CHECK(!s.has_member("k150"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,148 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_serializer.hpp>
+#include <jsoncons/output_sinks.hpp>
+#include <jsoncons_ext/csv/csv_serializer.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <cstdio>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(output_sinks_tests)
+
+const std::string input = R"({"ids":[1,2,3],"name":"Jane Roe","note":"a\"b","score":0.5})";
+
+BOOST_AUTO_TEST_CASE(test_string_sink)
+{
+    json j = json::parse(input);
+
+    std::string s = "previous contents";
+    j.dump(s);
+    BOOST_CHECK_EQUAL(input, s);
+
+    std::string s2;
+    {
+        basic_json_serializer<char,string_sink<std::string>> serializer(s2, serialization_options(), true);
+        j.dump(serializer);
+    }
+    std::ostringstream os;
+    j.dump(os, serialization_options(), true);
+    BOOST_CHECK_EQUAL(os.str(), s2);
+
+    std::wstring ws;
+    wjson::parse(L"[\"\\u00e9\",1]").dump(ws);
+    BOOST_CHECK(ws == L"[\"\u00e9\",1]");
+}
+
+BOOST_AUTO_TEST_CASE(test_fixed_buffer_sink)
+{
+    json j = json::parse(input);
+
+    std::vector<char> v(input.length());
+    fixed_buffer fits(v.data(), v.size());
+    {
+        basic_json_serializer<char,fixed_buffer_sink<char>> serializer(fits);
+        j.dump(serializer);
+    }
+    BOOST_CHECK(!fits.overflow());
+    BOOST_CHECK_EQUAL(input.length(), fits.size());
+    BOOST_CHECK_EQUAL(input, std::string(fits.data(), fits.size()));
+
+    char small[10];
+    fixed_buffer overflows(small, sizeof(small));
+    {
+        basic_json_serializer<char,fixed_buffer_sink<char>> serializer(overflows);
+        j.dump(serializer);
+    }
+    BOOST_CHECK(overflows.overflow());
+    BOOST_CHECK_EQUAL(10, overflows.size());
+    BOOST_CHECK_EQUAL(input.length(), overflows.required_size());
+    BOOST_CHECK_EQUAL(input.substr(0,10), std::string(overflows.data(), overflows.size()));
+}
+
+BOOST_AUTO_TEST_CASE(test_csv_string_sink)
+{
+    json j = json::parse(R"([{"a":1,"b":"x,y"}])");
+
+    std::string s;
+    {
+        csv::basic_csv_serializer<char,string_sink<std::string>> serializer(s);
+        j.dump(serializer);
+    }
+    std::ostringstream os;
+    {
+        csv::csv_serializer serializer(os);
+        j.dump(serializer);
+    }
+    BOOST_CHECK_EQUAL(os.str(), s);
+}
+
+#if defined(JSONCONS_HAS_POSIX_IO)
+
+std::string read_all(std::FILE* f)
+{
+    std::rewind(f);
+    std::string s;
+    char buf[256];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0)
+    {
+        s.append(buf, n);
+    }
+    return s;
+}
+
+BOOST_AUTO_TEST_CASE(test_fd_sink)
+{
+    json j = json::parse(input);
+
+    std::FILE* f = std::tmpfile();
+    BOOST_REQUIRE(f != nullptr);
+    {
+        basic_json_serializer<char,fd_sink> serializer(fileno(f));
+        j.dump(serializer);
+    }
+    BOOST_CHECK_EQUAL(input, read_all(f));
+    std::fclose(f);
+}
+
+BOOST_AUTO_TEST_CASE(test_iovec_sink)
+{
+    json j = json::parse(input);
+
+    // Small blocks so that the text spans several, and strings span blocks
+    iovec_buffer buffer(7);
+    {
+        basic_json_serializer<char,iovec_sink> serializer(buffer);
+        j.dump(serializer);
+    }
+    BOOST_CHECK_EQUAL(input.length(), buffer.size());
+
+    std::vector<struct iovec> v = buffer.iovecs();
+    BOOST_CHECK_EQUAL((input.length() + 6) / 7, v.size());
+    std::string s;
+    for (const auto& iov : v)
+    {
+        s.append(static_cast<const char*>(iov.iov_base), iov.iov_len);
+    }
+    BOOST_CHECK_EQUAL(input, s);
+
+    std::FILE* f = std::tmpfile();
+    BOOST_REQUIRE(f != nullptr);
+    buffer.write_to(fileno(f));
+    BOOST_CHECK_EQUAL(input, read_all(f));
+    std::fclose(f);
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
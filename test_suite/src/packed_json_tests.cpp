@@ -0,0 +1,200 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <ctime>
+#include <array>
+#include <thread>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(packed_json_tests)
+
+typedef basic_json<char,packed_json_traits<char>> pjson;
+
+BOOST_AUTO_TEST_CASE(test_packed_doubles)
+{
+    std::string s = "[1.5,-2.25,3.0,0.1,1e-07,6.02e+23,7.5,8.25,9.125]";
+    pjson j = pjson::parse(s);
+
+    BOOST_CHECK(j.array_value().packing() == array_packing::doubles);
+    BOOST_CHECK_EQUAL(9, j.size());
+    BOOST_CHECK_EQUAL(json::parse(s).to_string(), j.to_string());
+    BOOST_CHECK(j.is<std::vector<double>>());
+    BOOST_CHECK(!j.is<std::vector<std::string>>());
+
+    std::vector<double> v = j.as<std::vector<double>>();
+    BOOST_CHECK(j.array_value().packing() == array_packing::doubles);
+    BOOST_CHECK_EQUAL(9, v.size());
+    BOOST_CHECK_EQUAL(-2.25, v[1]);
+    BOOST_CHECK_EQUAL(9.125, v[8]);
+
+    j.add(10.5);
+    BOOST_CHECK(j.array_value().packing() == array_packing::doubles);
+    BOOST_CHECK_EQUAL(10, j.size());
+
+    pjson copy = j;
+    BOOST_CHECK(copy == j);
+
+    // Accessing an element unpacks the array
+    BOOST_CHECK_EQUAL(1.5, j[0].as<double>());
+    BOOST_CHECK(j.array_value().packing() == array_packing::none);
+    BOOST_CHECK(copy == j);
+    BOOST_CHECK_EQUAL(json::parse(s).to_string(), pjson::parse(s).to_string());
+}
+
+BOOST_AUTO_TEST_CASE(test_packed_integers)
+{
+    pjson j = pjson::parse("[1,-2,3,4,5,6,7,8,9223372036854775807]");
+
+    BOOST_CHECK(j.array_value().packing() == array_packing::integers);
+    BOOST_CHECK_EQUAL(std::string("[1,-2,3,4,5,6,7,8,9223372036854775807]"), j.to_string());
+
+    std::vector<int64_t> v = j.as<std::vector<int64_t>>();
+    BOOST_CHECK_EQUAL(-2, v[1]);
+    BOOST_CHECK_EQUAL((std::numeric_limits<int64_t>::max)(), v[8]);
+    BOOST_CHECK(j.is<std::vector<int64_t>>());
+    BOOST_CHECK(!j.is<std::vector<int>>());
+
+    std::vector<double> d = j.as<std::vector<double>>();
+    BOOST_CHECK_EQUAL(-2.0, d[1]);
+
+    // A string does not fit, so the array is unpacked
+    j.add("ten");
+    BOOST_CHECK(j.array_value().packing() == array_packing::none);
+    BOOST_CHECK_EQUAL(10, j.size());
+    BOOST_CHECK_EQUAL(std::string("[1,-2,3,4,5,6,7,8,9223372036854775807,\"ten\"]"), j.to_string());
+}
+
+BOOST_AUTO_TEST_CASE(test_packed_const_conversions)
+{
+    const pjson d = pjson::parse("[1.5,-2.25,3.0,0.1,1e-07,6.02e+23,7.5,8.25]");
+    const pjson n = pjson::parse("[1,0,3,4,5,6,7,8]");
+
+    // Conversions through a const reference leave the arrays packed
+    std::vector<pjson> elements = d.as<std::vector<pjson>>();
+    BOOST_CHECK(d.array_value().packing() == array_packing::doubles);
+    BOOST_CHECK_EQUAL(8, elements.size());
+    BOOST_CHECK_EQUAL(std::string("3.0"), elements[2].to_string());
+
+    BOOST_CHECK(d.is<std::vector<pjson>>());
+    BOOST_CHECK(!d.is<std::vector<std::string>>());
+    std::vector<bool> flags = n.as<std::vector<bool>>();
+    BOOST_CHECK(n.array_value().packing() == array_packing::integers);
+    BOOST_CHECK(flags[0] && !flags[1]);
+
+    BOOST_CHECK((n.is<std::array<int,8>>()));
+    BOOST_CHECK(!(n.is<std::array<int,7>>()));
+    std::array<int,8> a = n.as<std::array<int,8>>();
+    BOOST_CHECK(n.array_value().packing() == array_packing::integers);
+    BOOST_CHECK_EQUAL(8, a[7]);
+
+    std::array<double,8> b = d.as<std::array<double,8>>();
+    BOOST_CHECK(d.array_value().packing() == array_packing::doubles);
+    BOOST_CHECK_EQUAL(-2.25, b[1]);
+}
+
+BOOST_AUTO_TEST_CASE(test_packed_const_access_threads)
+{
+    std::string s = "[";
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        s += (i == 0 ? "" : ",") + std::to_string(i) + ".5";
+    }
+    s += "]";
+    const pjson j = pjson::parse(s);
+    const pjson copy = j;
+    BOOST_CHECK(j.array_value().packing() == array_packing::doubles);
+
+    // Both threads index, iterate and compare the same const document
+    std::vector<size_t> mismatches(2, 0);
+    auto read = [&](size_t k)
+    {
+        for (size_t i = 0; i < j.size(); ++i)
+        {
+            if (j[i].as<double>() != i + 0.5)
+            {
+                ++mismatches[k];
+            }
+        }
+        size_t i = 0;
+        for (const auto& val : j.array_range())
+        {
+            if (val.as<double>() != i++ + 0.5)
+            {
+                ++mismatches[k];
+            }
+        }
+        if (!(j == copy))
+        {
+            ++mismatches[k];
+        }
+    };
+    std::thread t(read, 0);
+    read(1);
+    t.join();
+
+    BOOST_CHECK_EQUAL(0, mismatches[0]);
+    BOOST_CHECK_EQUAL(0, mismatches[1]);
+    BOOST_CHECK(j.array_value().packing() == array_packing::doubles);
+    BOOST_CHECK_EQUAL(s, j.to_string());
+
+    // A packed array and an unpacked one compare element by element
+    pjson unpacked = pjson::parse(s);
+    unpacked[0];
+    BOOST_CHECK(unpacked.array_value().packing() == array_packing::none);
+    BOOST_CHECK(j == unpacked);
+    BOOST_CHECK(unpacked == copy);
+    BOOST_CHECK(copy.array_value().packing() == array_packing::doubles);
+
+    // Changing the document after const access keeps the two forms in step
+    pjson m = pjson::parse(s);
+    const pjson& cm = m;
+    BOOST_CHECK_EQUAL(0.5, cm[0].as<double>());
+    m.add(1.25);
+    BOOST_CHECK_EQUAL(1.25, cm[10000].as<double>());
+    m.remove_range(0, 1);
+    BOOST_CHECK_EQUAL(1.5, cm[0].as<double>());
+    m[0] = 7;
+    BOOST_CHECK_EQUAL(7, cm[0].as<int>());
+    BOOST_CHECK_EQUAL(10000, m.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_not_packed)
+{
+    pjson mixed = pjson::parse("[1,2,3,4,5,6,7,8.5]");
+    BOOST_CHECK(mixed.array_value().packing() == array_packing::none);
+
+    pjson large = pjson::parse("[1,2,3,4,5,6,7,18446744073709551615]");
+    BOOST_CHECK(large.array_value().packing() == array_packing::none);
+
+    pjson small = pjson::parse("[1.5,2.5]");
+    BOOST_CHECK(small.array_value().packing() == array_packing::none);
+}
+
+BOOST_AUTO_TEST_CASE(test_packed_remove_range)
+{
+    pjson j = pjson::parse(R"({"a":[0,1,2,3,4,5,6,7,8,9]})");
+    pjson& a = j.at("a");
+
+    a.remove_range(2, 8);
+    BOOST_CHECK(a.array_value().packing() == array_packing::integers);
+    BOOST_CHECK_EQUAL(std::string(R"({"a":[0,1,8,9]})"), j.to_string());
+
+    for (auto& val : a.array_range())
+    {
+        val = val.as<int>() * 2;
+    }
+    BOOST_CHECK_EQUAL(std::string(R"({"a":[0,2,16,18]})"), j.to_string());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
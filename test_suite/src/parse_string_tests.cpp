@@ -134,6 +134,99 @@ BOOST_AUTO_TEST_CASE(test_parse_big_string2)
     //}
 }
 
+BOOST_AUTO_TEST_CASE(test_parse_long_string_escape_positions)
+{
+    for (size_t i = 0; i < 70; ++i)
+    {
+        std::string expected = std::string(i,'a') + "\"" + std::string(70-i,'b');
+        std::string input = "[\"" + std::string(i,'a') + "\\\"" + std::string(70-i,'b') + "\"]";
+
+        json j = json::parse(input);
+        BOOST_CHECK_EQUAL(expected,j[0].as<std::string>());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_long_string_control_character_positions)
+{
+    for (size_t i = 0; i < 70; ++i)
+    {
+        std::string input = "[\"" + std::string(i,'a') + '\x01' + std::string(70-i,'b') + "\"]";
+
+        size_t column = 0;
+        try
+        {
+            json::parse(input);
+        }
+        catch (const parse_exception& e)
+        {
+            BOOST_CHECK(e.code() == json_parser_errc::illegal_control_character);
+            BOOST_CHECK_EQUAL(1,e.line_number());
+            column = e.column_number();
+        }
+        BOOST_CHECK_EQUAL(i == 0 ? 3 : i+4,column);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_long_string_chunked)
+{
+    std::string expected = std::string(100,'a') + "\n" + std::string(100,'b');
+    std::string input = "\"" + std::string(100,'a') + "\\n" + std::string(100,'b') + "\"";
+
+    for (size_t i = 2; i < input.length(); i += 7)
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder);
+        reader.buffer_capacity(i);
+        reader.read_next();
+        BOOST_CHECK(decoder.is_valid());
+        BOOST_CHECK_EQUAL(expected,decoder.get_result().as<std::string>());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_contiguous_strings)
+{
+    std::string long_string(100,'x');
+    std::string input = "{\"name\":\"value\",\"" + long_string + "\":[\"" + long_string + 
+                        "\",\"a\\nb\",\"\xE2\x82\xAC\"]}";
+    json expected = json::parse(input);
+
+    for (size_t i = 1; i < input.length(); ++i)
+    {
+        for (bool contiguous : {true, false})
+        {
+            std::istringstream is(input);
+            json_decoder<json> decoder;
+            json_reader reader(is, decoder);
+            reader.buffer_capacity(i);
+            reader.contiguous_strings(contiguous);
+            reader.read();
+            BOOST_CHECK(decoder.is_valid());
+            BOOST_CHECK(expected == decoder.get_result());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_deferred_string)
+{
+    json_decoder<json> decoder;
+    json_parser parser(decoder);
+    parser.defer_partial_strings(true);
+
+    std::string chunk1 = "[\"abc";
+    parser.set_source(chunk1.data(),chunk1.length());
+    parser.parse();
+    BOOST_CHECK_EQUAL(3,parser.deferred_length());
+
+    std::string chunk2 = "abcdef\"]";
+    parser.set_source(chunk2.data(),chunk2.length());
+    parser.parse();
+    parser.end_parse();
+    parser.check_done();
+    BOOST_CHECK_EQUAL(0,parser.deferred_length());
+    BOOST_CHECK_EQUAL(std::string("abcdef"),decoder.get_result()[0].as<std::string>());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
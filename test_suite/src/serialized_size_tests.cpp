@@ -0,0 +1,110 @@
+// Copyright 2017 Daniel Parker
+// Distributed under Boost license
+
+#ifdef __linux__
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#include <boost/test/unit_test.hpp>
+#include <jsoncons/json.hpp>
+#include <sstream>
+#include <vector>
+#include <utility>
+#include <cmath>
+
+using namespace jsoncons;
+
+BOOST_AUTO_TEST_SUITE(serialized_size_tests)
+
+typedef basic_json<char,compact_json_traits<char>> cjson;
+typedef basic_json<char,packed_json_traits<char>> pjson;
+
+const std::vector<std::string> documents = {
+    R"({"a":[1,-2,3.5,1e300,-0.0,5e-324,0.1,"x\"\\\/\n\t\u0001\u007f\u00e9\ud83d\ude00",null,true,false,{},[]],"b":{"c":-9223372036854775808,"d":18446744073709551615},"":""})",
+    "[]",
+    "{}",
+    "0",
+    "\"\"",
+    "[1,2,3,4,5,6,7,8,9,10]",
+    "[1.5,2.5,3.5,4.5,5.5,6.5,7.5,8.5,9.123456789]",
+    "[1E5,2.50,-0.000,123.4500]"
+};
+
+template <class Json>
+void check_size(const Json& val, const basic_serialization_options<typename Json::char_type>& options)
+{
+    BOOST_CHECK_EQUAL(val.to_string(options).length(), serialized_size(val, options));
+}
+
+BOOST_AUTO_TEST_CASE(test_serialized_size)
+{
+    serialization_options escape_all;
+    escape_all.escape_all_non_ascii(true)
+              .escape_solidus(true);
+    serialization_options precision6;
+    precision6.precision(6);
+
+    for (const auto& s : documents)
+    {
+        json j = json::parse(s);
+        BOOST_CHECK_EQUAL(j.to_string().length(), serialized_size(j));
+        check_size(j, escape_all);
+        check_size(j, precision6);
+
+        check_size(ojson::parse(s), serialization_options());
+        check_size(cjson::parse(s), serialization_options());
+        check_size(pjson::parse(s), serialization_options());
+
+        wjson w = wjson::parse(std::wstring(s.begin(), s.end()));
+        check_size(w, wserialization_options());
+        wserialization_options w_escape_all;
+        w_escape_all.escape_all_non_ascii(true);
+        check_size(w, w_escape_all);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_serialized_size_nan)
+{
+    json a = json::array();
+    a.add(std::nan(""));
+    a.add(HUGE_VAL);
+    a.add(-HUGE_VAL);
+
+    check_size(a, serialization_options());
+
+    serialization_options options;
+    options.nan_replacement("\"NaN\"")
+           .pos_inf_replacement("\"Infinity\"")
+           .neg_inf_replacement("\"-Infinity\"");
+    check_size(a, options);
+}
+
+BOOST_AUTO_TEST_CASE(test_serialized_size_reserve)
+{
+    json j = json::parse(documents[0]);
+
+    std::string s;
+    s.reserve(serialized_size(j));
+    const char* data = s.data();
+    j.dump(s);
+
+    // The text fits the reserved capacity exactly, so there was no reallocation
+    BOOST_CHECK(data == s.data());
+    BOOST_CHECK_EQUAL(j.to_string(), s);
+}
+
+BOOST_AUTO_TEST_CASE(test_counting_sink)
+{
+    json j = json::parse(documents[0]);
+
+    size_t count = 0;
+    {
+        basic_json_serializer<char,counting_sink<char>> serializer(count, serialization_options(), true);
+        j.dump(serializer);
+    }
+    std::ostringstream os;
+    os << pretty_print(j);
+    BOOST_CHECK_EQUAL(os.str().length(), count);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
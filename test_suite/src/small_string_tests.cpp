@@ -36,5 +36,33 @@ BOOST_AUTO_TEST_CASE(test_small_string)
     BOOST_CHECK(q.as<std::string>() == std::string("ABCD"));
 }
 
+BOOST_AUTO_TEST_CASE(test_long_string)
+{
+    std::string expected(100, 'x');
+    json s(expected.data(), expected.length());
+    BOOST_CHECK(s.type_id() == jsoncons::value_type::string_t);
+    BOOST_CHECK(s.as<std::string>() == expected);
+    BOOST_CHECK(s.as_cstring() == expected);
+
+    json t(s);
+    BOOST_CHECK(t.type_id() == jsoncons::value_type::string_t);
+    BOOST_CHECK(t.as<std::string>() == expected);
+
+    json q("ABCD");
+    q.swap(t);
+    BOOST_CHECK(q.as<std::string>() == expected);
+    BOOST_CHECK(t.as<std::string>() == std::string("ABCD"));
+
+    json r(std::move(q));
+    BOOST_CHECK(r.as<std::string>() == expected);
+    r = json(std::string(20,'y'));
+    BOOST_CHECK(r.as<std::string>() == std::string(20,'y'));
+
+    std::wstring wexpected(30, L'w');
+    wjson w(wexpected.data(), wexpected.length());
+    BOOST_CHECK(w.type_id() == jsoncons::value_type::string_t);
+    BOOST_CHECK(w.as<std::wstring>() == wexpected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -9,6 +9,8 @@
 #include <utility>
 #include <ctime>
 #include <cwchar>
+#include <cstring>
+#include <cmath>
 
 using namespace jsoncons;
 
@@ -53,5 +55,40 @@ BOOST_AUTO_TEST_CASE(test_exponent)
     //std::cout << std::numeric_limits<double>::max() << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(test_decimal_to_double)
+{
+    std::vector<std::string> inputs = {
+        "0", "0.0", "1", "1.5", "0.1", "1e10", "1E-10", "1e+22", "1e23",
+        "9007199254740992", "9007199254740993", "9007199254740995",
+        "123456789012345678901234567890", "1.00000000000000011102230246251565404236316680908203125",
+        "2.2250738585072011e-308", "2.2250738585072014e-308", "4.9406564584124654e-324",
+        "1.7976931348623157e308", "1.7976931348623159e308", "1e400", "1e-400",
+        "7.2057594037927933e16", "0.000000000000000000000000000000000001"
+    };
+
+    string_to_double<char> reader;
+    for (const auto& s : inputs)
+    {
+        double expected = strtod(s.c_str(), nullptr);
+        double value = reader(s.c_str(), s.length());
+        BOOST_CHECK_MESSAGE(std::memcmp(&expected,&value,sizeof(double)) == 0, s);
+
+        double d;
+        if (try_decimal_to_double(s.c_str(), d))
+        {
+            BOOST_CHECK_MESSAGE(std::memcmp(&expected,&d,sizeof(double)) == 0, s);
+        }
+    }
+
+    double d;
+    BOOST_CHECK(try_decimal_to_double("-0", d));
+    BOOST_CHECK(std::signbit(d));
+    BOOST_CHECK(!try_decimal_to_double("0x10", d));
+    BOOST_CHECK(!try_decimal_to_double("inf", d));
+    BOOST_CHECK(!try_decimal_to_double(".5", d));
+    BOOST_CHECK(try_decimal_to_double(L"1.25e2", d));
+    BOOST_CHECK_EQUAL(125.0,d);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
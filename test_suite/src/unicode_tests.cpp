@@ -31,6 +31,66 @@ BOOST_AUTO_TEST_CASE( test_is_same_size )
 {
 }
 
+BOOST_AUTO_TEST_CASE(test_simd_validate)
+{
+    std::vector<std::string> sequences = {
+        "\xC3\xA9",             // valid 2 byte
+        "\xE2\x82\xAC",         // valid 3 byte
+        "\xF0\x9F\x98\x80",     // valid 4 byte
+        "\xC0\x80",             // overlong 2 byte
+        "\xE0\x80\xAF",         // overlong 3 byte
+        "\xF0\x80\x80\xAF",     // overlong 4 byte
+        "\xED\xA0\x80",         // surrogate
+        "\xF4\x90\x80\x80",     // too large
+        "\xF8\x88\x80\x80\x80", // 5 byte
+        "\x80",                 // stray continuation
+        "\xE2\x82",             // truncated 3 byte
+        "\xC3\xA9\xA9",         // too many continuations
+        "\xFF"
+    };
+
+    for (const auto& seq : sequences)
+    {
+        for (size_t i = 0; i < 70; ++i)
+        {
+            std::string s = std::string(i,'a') + seq + std::string(70-i,'b');
+            const char* first = s.data();
+            const char* last = s.data() + s.length();
+
+            auto expected = unicons::validate(first,last);
+            auto result = simd::validate(first,last);
+            BOOST_CHECK(expected.first == result.first);
+            BOOST_CHECK_EQUAL(expected.second-first,result.second-first);
+
+            // sequence at the end of the input
+            std::string t = std::string(i,'a') + seq;
+            expected = unicons::validate(t.data(),t.data()+t.length());
+            result = simd::validate(t.data(),t.data()+t.length());
+            BOOST_CHECK(expected.first == result.first);
+            BOOST_CHECK_EQUAL(expected.second-t.data(),result.second-t.data());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parse_long_string_invalid_utf8)
+{
+    std::string valid = "\"" + std::string(40,'a') + "\xE2\x82\xAC" + std::string(40,'b') + "\"";
+    json j = json::parse(valid);
+    BOOST_CHECK_EQUAL(std::string(40,'a') + "\xE2\x82\xAC" + std::string(40,'b'), j.as<std::string>());
+
+    std::string invalid = "\"" + std::string(40,'a') + "\xE2\x82" + std::string(40,'b') + "\"";
+    std::error_code ec;
+    try
+    {
+        json::parse(invalid);
+    }
+    catch (const parse_exception& e)
+    {
+        ec = e.code();
+    }
+    BOOST_CHECK(ec == json_parser_errc::expected_continuation_byte);
+}
+
 #if 0
 
 BOOST_AUTO_TEST_CASE( test_surrogate_pair )